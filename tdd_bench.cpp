@@ -0,0 +1,606 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph benchmarks
+//
+// $NoKeywords: $ivs_project_1 $tdd_bench.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_bench.cpp
+ * @author David Bujzaš
+ *
+ * @brief Měření výkonu operací nad grafem.
+ *
+ * Použití: tdd_bench [počet uzlů] [počet uzlů pro lineární vyhledávání]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tdd_code.h"
+#include "tdd_compressed_graph.h"
+#include "tdd_concurrent_graph.h"
+#include "tdd_csr_graph.h"
+#include "tdd_graph_generators.h"
+#include "tdd_graph_log.h"
+#include "tdd_scheduler.h"
+#include "tdd_subgraph.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// returns seconds elapsed since the given time point
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// prints one measurement with the cost per operation
+void report(const char* name, size_t operations, double seconds) {
+    std::cout << name << ": " << operations << " ops, " << seconds << " s, "
+              << seconds * 1e9 / static_cast<double>(operations) << " ns/op" << std::endl;
+}
+
+// ids are spread over the whole size_t range like hashed ids in real workloads
+size_t nodeIdAt(size_t i) {
+    return i * 0x9E3779B97F4A7C15ULL;
+}
+
+// loads nodes the way Graph::addNode did before the id index, by scanning all nodes
+double loadNodesLinear(size_t count) {
+    std::vector<Node*> nodes;
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; i++) {
+        size_t id = nodeIdAt(i);
+        bool exists = false;
+        for (auto node : nodes) {
+            if (node->id == id) {
+                exists = true;
+                break;
+            }
+        }
+        if (!exists) {
+            nodes.push_back(new Node{id, 0});
+        }
+    }
+    double seconds = secondsSince(start);
+    for (auto node : nodes) {
+        delete node;
+    }
+    return seconds;
+}
+
+double loadNodesIndexed(size_t count) {
+    Graph graph;
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; i++) {
+        graph.addNode(nodeIdAt(i));
+    }
+    return secondsSince(start);
+}
+
+double lookupNodesIndexed(size_t count) {
+    Graph graph;
+    for (size_t i = 0; i < count; i++) {
+        graph.addNode(nodeIdAt(i));
+    }
+
+    size_t found = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; i++) {
+        found += graph.getNode(nodeIdAt(i)) != nullptr;
+    }
+    double seconds = secondsSince(start);
+    if (found != count) {
+        std::cerr << "lookup failed" << std::endl;
+    }
+    return seconds;
+}
+
+// random edges over nodeCount nodes, the same sequence on every call
+std::vector<Edge> randomEdges(size_t nodeCount, size_t edgeCount) {
+    std::vector<Edge> edges;
+    edges.reserve(edgeCount);
+    uint64_t state = 1;
+    for (size_t i = 0; i < edgeCount; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        edges.emplace_back(nodeIdAt((state >> 33) % nodeCount), nodeIdAt((state >> 7) % nodeCount));
+    }
+    return edges;
+}
+
+// loads the edges with one addMultipleEdges call
+double loadEdgesBulk(size_t nodeCount, size_t edgeCount, size_t threadCount) {
+    std::vector<Edge> edges = randomEdges(nodeCount, edgeCount);
+    Graph graph;
+    auto start = Clock::now();
+    graph.addMultipleEdges(edges, threadCount);
+    return secondsSince(start);
+}
+
+// loads the same edges in batches of batchSize, a batch must cost time proportional to its size
+double loadEdgesBatched(size_t nodeCount, size_t edgeCount, size_t batchSize) {
+    std::vector<Edge> edges = randomEdges(nodeCount, edgeCount);
+    Graph graph;
+    std::vector<Edge> batch;
+    auto start = Clock::now();
+    for (size_t begin = 0; begin < edges.size(); begin += batchSize) {
+        batch.assign(edges.begin() + begin, edges.begin() + std::min(edges.size(), begin + batchSize));
+        graph.addMultipleEdges(batch);
+    }
+    return secondsSince(start);
+}
+
+// imports the same edge list with shrinking chunks, small chunks bound memory and must not cost much more
+void benchImportChunks(size_t nodeCount, size_t edgeCount) {
+    std::string path = (std::filesystem::temp_directory_path() / "tdd_bench_edges.txt").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        for (auto& edge : randomEdges(nodeCount, edgeCount)) {
+            file << edge.a % nodeCount << ' ' << edge.b % nodeCount << '\n';
+        }
+    }
+
+    double largest = 0;
+    for (size_t chunkSize : {size_t(64) << 20, size_t(1) << 20, size_t(64) << 10}) {
+        Graph graph;
+        auto start = Clock::now();
+        graph.importEdgeList(path, chunkSize);
+        double seconds = secondsSince(start);
+        largest = largest == 0 ? seconds : largest;
+        std::cout << "importEdgeList chunk " << (chunkSize >> 10) << " KiB: " << seconds << " s, "
+                  << seconds / largest << "x of the 64 MiB chunk" << std::endl;
+    }
+    std::remove(path.c_str());
+}
+
+// mixed workload of 90 % containsEdge and nodeDegree reads and 10 % addEdge writes on threadCount threads
+template<typename Operation>
+double runMixedWorkload(size_t nodeCount, size_t operationCount, size_t threadCount, Operation operation) {
+    auto start = Clock::now();
+    parallelFor(operationCount, threadCount, [&](size_t begin, size_t end, size_t thread) {
+        uint64_t state = thread + 1;
+        for (size_t i = begin; i < end; i++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            Edge edge(nodeIdAt((state >> 33) % nodeCount), nodeIdAt((state >> 7) % nodeCount));
+            operation(edge, (state >> 40) % 10);
+        }
+    });
+    return secondsSince(start);
+}
+
+// one global mutex around the single-threaded Graph, the way ingest and query threads share it today
+double stressLockedGraph(size_t nodeCount, size_t operationCount, size_t threadCount) {
+    Graph graph;
+    std::mutex mutex;
+    for (size_t i = 0; i < nodeCount; i++) {
+        graph.addEdge(Edge(nodeIdAt(i), nodeIdAt((i * 7 + 1) % nodeCount)));
+    }
+    return runMixedWorkload(nodeCount, operationCount, threadCount, [&](const Edge& edge, size_t kind) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (kind == 0) {
+            graph.addEdge(edge);
+        } else if (kind < 5) {
+            graph.containsEdge(edge);
+        } else if (graph.getNode(edge.a) != nullptr) {
+            graph.nodeDegree(edge.a);
+        }
+    });
+}
+
+double stressConcurrentGraph(size_t nodeCount, size_t operationCount, size_t threadCount) {
+    ConcurrentGraph graph;
+    for (size_t i = 0; i < nodeCount; i++) {
+        graph.addEdge(Edge(nodeIdAt(i), nodeIdAt((i * 7 + 1) % nodeCount)));
+    }
+    return runMixedWorkload(nodeCount, operationCount, threadCount, [&](const Edge& edge, size_t kind) {
+        if (kind == 0) {
+            graph.addEdge(edge);
+        } else if (kind < 5) {
+            graph.containsEdge(edge);
+        } else if (graph.containsNode(edge.a)) {
+            graph.nodeDegree(edge.a);
+        }
+    });
+}
+
+// side x side grid whose nodes are inserted in a scattered order, like ids arriving from a hashed ingest
+void buildScatteredGrid(Graph& graph, size_t side) {
+    size_t count = side * side;
+    std::vector<size_t> position(count);
+    for (size_t i = 0; i < count; i++) {
+        position[i] = i;
+    }
+    std::shuffle(position.begin(), position.end(), std::mt19937_64(1));
+    for (size_t i = 0; i < count; i++) {
+        graph.addNode(nodeIdAt(position[i]));
+    }
+
+    std::vector<Edge> edges;
+    edges.reserve(2 * count);
+    for (size_t i = 0; i < count; i++) {
+        if (i % side + 1 < side) {
+            edges.emplace_back(nodeIdAt(i), nodeIdAt(i + 1));
+        }
+        if (i + side < count) {
+            edges.emplace_back(nodeIdAt(i), nodeIdAt(i + side));
+        }
+    }
+    graph.addMultipleEdges(edges);
+}
+
+// times smallest-last coloring on the scattered grid, optionally after reordering it
+void benchReorder(const char* name, size_t side, const ReorderStrategy* strategy) {
+    Graph graph;
+    buildScatteredGrid(graph, side);
+
+    double gap = graph.averageGap();
+    double reorderSeconds = 0;
+    if (strategy != nullptr) {
+        auto start = Clock::now();
+        gap = graph.reorder(*strategy).gapAfter;
+        reorderSeconds = secondsSince(start);
+    }
+
+    auto start = Clock::now();
+    graph.coloring(ColoringStrategy::SmallestLast);
+    double seconds = secondsSince(start);
+    std::cout << "coloring after " << name << ": gap " << gap << ", reorder " << reorderSeconds << " s, ";
+    report("smallest-last", graph.nodeCount(), seconds);
+}
+
+// intersects pairs of sorted lists with random gaps, so the scalar merge cannot predict its branches
+void benchIntersect(const char* name, IntersectKernel kernel, size_t listSize, size_t repeats) {
+    if (!intersectKernelAvailable(kernel)) {
+        std::cout << name << ": not available" << std::endl;
+        return;
+    }
+
+    std::mt19937 random(3);
+    std::vector<uint32_t> a(listSize);
+    std::vector<uint32_t> b(listSize);
+    for (size_t i = 0; i < listSize; i++) {
+        a[i] = (i > 0 ? a[i - 1] : 0) + 1 + random() % 3;
+        b[i] = (i > 0 ? b[i - 1] : 0) + 1 + random() % 3;
+    }
+
+    size_t common = 0;
+    auto start = Clock::now();
+    for (size_t r = 0; r < repeats; r++) {
+        common += intersectSortedCount(a.data(), a.size(), b.data(), b.size(), kernel);
+    }
+    double seconds = secondsSince(start);
+    std::cout << "common " << common / repeats << ", ";
+    report(name, repeats * 2 * listSize, seconds);
+}
+
+// triangle counting on a random graph dense enough for the oriented lists to fill SIMD blocks
+void benchTriangles(const char* name, IntersectKernel kernel, size_t nodeCount, size_t threadCount) {
+    if (!intersectKernelAvailable(kernel)) {
+        std::cout << name << ": not available" << std::endl;
+        return;
+    }
+
+    Graph graph;
+    std::vector<Edge> edges;
+    uint64_t state = 7;
+    for (size_t i = 0; i < 50 * nodeCount; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        edges.emplace_back(nodeIdAt((state >> 33) % nodeCount), nodeIdAt((state >> 7) % nodeCount));
+    }
+    graph.addMultipleEdges(edges, threadCount);
+
+    auto start = Clock::now();
+    size_t triangles = graph.triangleCount(threadCount, kernel);
+    double seconds = secondsSince(start);
+    std::cout << "triangles " << triangles << ", ";
+    report(name, graph.edgeCount(), seconds);
+}
+
+// runs the same queries on an uncompressed and a compressed snapshot of a random graph
+template<typename Snapshot>
+void benchSnapshot(const char* name, const Snapshot& snapshot, const std::vector<Edge>& queries,
+                   size_t memoryBytes) {
+    std::string prefix(name);
+    std::cout << prefix << " memory: " << memoryBytes / (1 << 20) << " MiB" << std::endl;
+
+    size_t found = 0;
+    auto start = Clock::now();
+    for (auto& edge : queries) {
+        found += snapshot.containsEdge(edge);
+    }
+    report((prefix + " containsEdge").c_str(), queries.size(), secondsSince(start));
+
+    size_t degrees = 0;
+    start = Clock::now();
+    for (auto& edge : queries) {
+        degrees += snapshot.nodeDegree(edge.a);
+    }
+    report((prefix + " nodeDegree").c_str(), queries.size(), secondsSince(start));
+
+    std::vector<size_t> colors(snapshot.nodeCount());
+    start = Clock::now();
+    size_t colorCount = snapshot.coloring(colors.data());
+    report((prefix + " coloring").c_str(), snapshot.nodeCount(), secondsSince(start));
+    std::cout << prefix << " found " << found << ", degrees " << degrees << ", colors " << colorCount << std::endl;
+}
+
+void benchCompression(size_t nodeCount, size_t averageDegree) {
+    std::vector<Edge> edges;
+    uint64_t state = 11;
+    for (size_t i = 0; i < nodeCount * averageDegree / 2; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        edges.emplace_back(nodeIdAt((state >> 33) % nodeCount), nodeIdAt((state >> 7) % nodeCount));
+    }
+    Graph graph;
+    graph.addMultipleEdges(edges, 4);
+
+    // half of the queries are existing edges, half are random pairs
+    std::vector<Edge> queries;
+    for (size_t i = 0; i < edges.size(); i += 2) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        queries.push_back(edges[i]);
+        queries.emplace_back(nodeIdAt((state >> 33) % nodeCount), nodeIdAt((state >> 7) % nodeCount));
+    }
+
+    FrozenGraph frozen = graph.freeze();
+    size_t frozenBytes = (frozen.idArray().size() + frozen.offsetArray().size() + frozen.neighborArray().size())
+        * sizeof(uint64_t);
+    benchSnapshot("FrozenGraph", frozen, queries, frozenBytes);
+    CompressedGraph compressed(frozen);
+    benchSnapshot("CompressedGraph", compressed, queries, compressed.memoryBytes());
+    std::cout << "compression ratio: " << static_cast<double>(frozenBytes) / compressed.memoryBytes() << "x"
+              << std::endl;
+}
+
+// exact coloring of a dense random scheduling-sized graph against the DSatur upper bound
+void benchExactColoring(size_t nodeCount, double density, double timeBudget, size_t threadCount) {
+    Graph graph;
+    uint64_t state = 13;
+    for (size_t a = 0; a < nodeCount; a++) {
+        graph.addNode(a);
+        for (size_t b = a + 1; b < nodeCount; b++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            if (static_cast<double>(state >> 11) / 9007199254740992.0 < density) {
+                graph.addEdge(Edge(a, b));
+            }
+        }
+    }
+
+    size_t dsatur = graph.coloring(ColoringStrategy::DSatur);
+    auto start = Clock::now();
+    ExactColoring result = graph.optimalColoring(timeBudget, threadCount);
+    double seconds = secondsSince(start);
+    std::cout << "optimalColoring " << nodeCount << " nodes, " << threadCount << " threads: DSatur " << dsatur
+              << ", best " << result.colorCount << ", lower bound " << result.lowerBound
+              << (result.optimal ? ", optimal, " : ", budget exhausted, ") << seconds << " s" << std::endl;
+}
+
+// tasks update the counters of their resources, the edges of the conflict graph are shared resources
+void benchScheduler(size_t taskCount, size_t resourcesPerTask, size_t threadCount) {
+    size_t resourceCount = taskCount;
+    std::vector<std::vector<size_t>> resources(taskCount);
+    std::vector<std::vector<size_t>> users(resourceCount);
+    uint64_t state = 17;
+    for (size_t task = 0; task < taskCount; task++) {
+        for (size_t r = 0; r < resourcesPerTask; r++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            size_t resource = (state >> 33) % resourceCount;
+            resources[task].push_back(resource);
+            users[resource].push_back(task);
+        }
+    }
+
+    Graph graph;
+    std::vector<Edge> conflicts;
+    for (size_t task = 0; task < taskCount; task++) {
+        graph.addNode(task);
+    }
+    for (auto& tasks : users) {
+        for (size_t i = 0; i < tasks.size(); i++) {
+            for (size_t j = i + 1; j < tasks.size(); j++) {
+                conflicts.emplace_back(tasks[i], tasks[j]);
+            }
+        }
+    }
+    graph.addMultipleEdges(conflicts);
+    graph.coloring(ColoringStrategy::SmallestLast);
+
+    std::vector<uint64_t> counters(resourceCount, 0);
+    auto work = [&](size_t task) {
+        for (auto resource : resources[task]) {
+            uint64_t value = counters[resource];
+            for (size_t round = 0; round < 200; round++) {
+                value = value * 6364136223846793005ULL + task;
+            }
+            counters[resource] = value;
+        }
+    };
+
+    ColorScheduler scheduler(threadCount);
+    ScheduleStats stats = scheduler.run(graph, work);
+    size_t steals = 0;
+    double slowest = 0;
+    for (auto& colorClass : stats.classes) {
+        steals += colorClass.steals;
+        slowest = std::max(slowest, colorClass.seconds);
+    }
+    std::cout << "scheduler " << threadCount << " threads: " << stats.classes.size() << " classes, " << steals
+              << " steals, slowest class " << slowest << " s, ";
+    report("tasks", taskCount, stats.seconds);
+}
+
+// logs random edges with the given group commit size, then recovers once from the whole log
+// and once from a checkpoint followed by a short tail
+void benchGraphLog(size_t nodeCount, size_t edgeCount, size_t groupSize) {
+    std::string base = (std::filesystem::temp_directory_path() / "tdd_bench_graph_log").string();
+    std::remove((base + ".log").c_str());
+    std::remove((base + ".checkpoint").c_str());
+
+    std::mt19937_64 random(23);
+    double writing;
+    {
+        Graph graph;
+        GraphLog log(base, graph, groupSize, edgeCount + 1);
+        auto start = Clock::now();
+        for (size_t i = 0; i < edgeCount; i++) {
+            size_t a = random() % nodeCount;
+            size_t b = random() % nodeCount;
+            if (a != b) {
+                log.addEdge(Edge(a, b));
+            }
+        }
+        log.commit();
+        writing = secondsSince(start);
+    }
+    std::string suffix = " group " + std::to_string(groupSize);
+    report(("GraphLog append" + suffix).c_str(), edgeCount, writing);
+
+    {
+        Graph graph;
+        auto start = Clock::now();
+        GraphLog log(base, graph);
+        report(("GraphLog replay whole log" + suffix).c_str(), log.replayedRecords(), secondsSince(start));
+        log.checkpoint();
+        for (size_t i = 0; i < edgeCount / 100; i++) {
+            log.addEdge(Edge(random() % nodeCount, nodeCount + i));
+        }
+    }
+    {
+        Graph graph;
+        auto start = Clock::now();
+        GraphLog log(base, graph);
+        double recovery = secondsSince(start);
+        std::cout << "GraphLog checkpoint + tail of " << log.replayedRecords() << " records: " << recovery << " s"
+                  << std::endl;
+    }
+
+    std::remove((base + ".log").c_str());
+    std::remove((base + ".checkpoint").c_str());
+}
+
+// colors the two hop neighborhood of random nodes through a view and through a copied Graph
+void benchEgoColoring(size_t nodeCount, size_t centerCount) {
+    Graph graph;
+    graph.addMultipleEdges(generateEdges(GraphGenerator::ErdosRenyi, nodeCount, 8, 31));
+    std::mt19937_64 random(37);
+    std::vector<size_t> centers(centerCount);
+    for (auto& center : centers) {
+        center = graph.nodeIdAt(random() % graph.nodeCount());
+    }
+
+    size_t viewNodes = 0;
+    std::vector<size_t> colors;
+    auto start = Clock::now();
+    for (auto center : centers) {
+        SubgraphView view = SubgraphView::egoNetwork(graph, center, 2);
+        colors.resize(view.nodeCount());
+        view.coloring(colors.data());
+        viewNodes += view.nodeCount();
+    }
+    report("ego coloring SubgraphView", viewNodes, secondsSince(start));
+
+    size_t copiedNodes = 0;
+    start = Clock::now();
+    for (auto center : centers) {
+        SubgraphView view = SubgraphView::egoNetwork(graph, center, 2);
+        Graph copy;
+        for (size_t index = 0; index < view.nodeCount(); index++) {
+            copy.addNode(view.nodeIdAt(index));
+            view.forEachNeighbor(index, [&](size_t neighbor) {
+                if (index < neighbor) {
+                    copy.addEdge(Edge(view.nodeIdAt(index), view.nodeIdAt(neighbor)));
+                }
+            });
+        }
+        copy.coloring();
+        copiedNodes += copy.nodeCount();
+    }
+    report("ego coloring copied Graph", copiedNodes, secondsSince(start));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t nodeCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t linearCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+
+    double linear = loadNodesLinear(linearCount);
+    report("addNode linear scan", linearCount, linear);
+
+    double indexedSmall = loadNodesIndexed(linearCount);
+    report("addNode id index", linearCount, indexedSmall);
+    std::cout << "speedup at " << linearCount << " nodes: " << linear / indexedSmall << "x" << std::endl;
+
+    report("addNode id index", nodeCount, loadNodesIndexed(nodeCount));
+    report("getNode id index", nodeCount, lookupNodesIndexed(nodeCount));
+
+    size_t edgeCount = 4 * nodeCount;
+    report("addMultipleEdges 1 thread", edgeCount, loadEdgesBulk(nodeCount, edgeCount, 1));
+    report("addMultipleEdges 4 threads", edgeCount, loadEdgesBulk(nodeCount, edgeCount, 4));
+    for (size_t batchSize : {edgeCount / 10 + 1, edgeCount / 100 + 1, edgeCount / 1000 + 1}) {
+        report(("addMultipleEdges batches of " + std::to_string(batchSize)).c_str(), edgeCount,
+               loadEdgesBatched(nodeCount, edgeCount, batchSize));
+    }
+    benchImportChunks(nodeCount, edgeCount);
+
+    size_t stressNodes = nodeCount / 10 + 1;
+    size_t stressOperations = 2 * nodeCount;
+    for (size_t threads : {1, 2, 4, 8}) {
+        std::string suffix = " " + std::to_string(threads) + " threads";
+        report(("mixed ops Graph + mutex" + suffix).c_str(), stressOperations,
+               stressLockedGraph(stressNodes, stressOperations, threads));
+        report(("mixed ops ConcurrentGraph" + suffix).c_str(), stressOperations,
+               stressConcurrentGraph(stressNodes, stressOperations, threads));
+    }
+
+    size_t side = 1;
+    while (side * side < nodeCount) {
+        side++;
+    }
+    const ReorderStrategy rcm = ReorderStrategy::ReverseCuthillMcKee;
+    const ReorderStrategy degree = ReorderStrategy::DegreeDescending;
+    const ReorderStrategy hubs = ReorderStrategy::HubClustering;
+    benchReorder("insertion order", side, nullptr);
+    benchReorder("reverse Cuthill-McKee", side, &rcm);
+    benchReorder("degree descending", side, &degree);
+    benchReorder("hub clustering", side, &hubs);
+
+    benchIntersect("intersect scalar", IntersectKernel::Scalar, 4096, 20000);
+    benchIntersect("intersect SSE2", IntersectKernel::Sse2, 4096, 20000);
+    benchIntersect("intersect AVX2", IntersectKernel::Avx2, 4096, 20000);
+    size_t triangleNodes = nodeCount / 20 + 1;
+    benchTriangles("triangleCount scalar", IntersectKernel::Scalar, triangleNodes, 1);
+    benchTriangles("triangleCount SSE2", IntersectKernel::Sse2, triangleNodes, 1);
+    benchTriangles("triangleCount AVX2", IntersectKernel::Avx2, triangleNodes, 1);
+    benchTriangles("triangleCount best 4 threads", IntersectKernel::Best, triangleNodes, 4);
+
+    benchCompression(nodeCount / 4 + 1, 32);
+
+    benchExactColoring(70, 0.5, 10, 1);
+    benchExactColoring(70, 0.5, 10, 4);
+    benchExactColoring(300, 0.1, 2, 4);
+
+    for (size_t threads : {1, 2, 4, 8}) {
+        benchScheduler(nodeCount / 10 + 1, 4, threads);
+    }
+
+    benchGraphLog(nodeCount / 10 + 1, 1000, 1);
+    benchGraphLog(nodeCount / 10 + 1, nodeCount, 1024);
+
+    benchEgoColoring(nodeCount, 1000);
+
+    return 0;
+}
+
+/*** Konec souboru tdd_bench.cpp ***/
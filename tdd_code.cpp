@@ -16,6 +16,180 @@
 
 #include "tdd_code.h"
 
+#include <atomic>
+#include <queue>
+#include <tuple>
+
+const size_t NodeIndex::npos;
+const size_t NodeArena::CHUNK_SIZE;
+
+Node* NodeArena::allocate() {
+    // reuses a slot of a removed node first
+    if (!freeNodes.empty()) {
+        Node* node = freeNodes.back();
+        freeNodes.pop_back();
+        return node;
+    }
+
+    // starts a new chunk once the last one is full
+    if (chunkUsed == CHUNK_SIZE) {
+        chunks.emplace_back(new Node[CHUNK_SIZE]);
+        chunkUsed = 0;
+    }
+    return &chunks.back()[chunkUsed++];
+}
+
+void NodeArena::release(Node* node) {
+    freeNodes.push_back(node);
+}
+
+void NodeArena::clear() {
+    chunks.clear();
+    freeNodes.clear();
+    chunkUsed = CHUNK_SIZE;
+}
+
+// finalizer of splitmix64, spreads sequential and clustered ids over the whole table
+size_t NodeIndex::hash(size_t key) {
+    uint64_t x = key;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<size_t>(x ^ (x >> 31));
+}
+
+// returns the slot holding the key or the empty slot where it would be inserted
+size_t NodeIndex::probe(size_t key) const {
+    size_t mask = slots.size() - 1;
+    size_t i = hash(key) & mask;
+    while (slots[i].value != npos && slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void NodeIndex::rehash(size_t newCapacity) {
+    std::vector<Slot> old(newCapacity, Slot{0, npos});
+    old.swap(slots);
+    for (auto& slot : old) {
+        if (slot.value != npos) {
+            slots[probe(slot.key)] = slot;
+        }
+    }
+}
+
+size_t NodeIndex::find(size_t key) const {
+    if (count == 0) {
+        return npos;
+    }
+    return slots[probe(key)].value;
+}
+
+bool NodeIndex::insert(size_t key, size_t value) {
+    // keeps the load factor at most 1/2 so probe sequences stay short
+    if ((count + 1) * 2 > slots.size()) {
+        rehash(slots.empty() ? 16 : slots.size() * 2);
+    }
+
+    size_t i = probe(key);
+    if (slots[i].value != npos) {
+        return false;
+    }
+    slots[i] = Slot{key, value};
+    count++;
+    return true;
+}
+
+void NodeIndex::assign(size_t key, size_t value) {
+    slots[probe(key)].value = value;
+}
+
+bool NodeIndex::erase(size_t key) {
+    if (count == 0) {
+        return false;
+    }
+
+    size_t mask = slots.size() - 1;
+    size_t i = probe(key);
+    if (slots[i].value == npos) {
+        return false;
+    }
+
+    // backward shift deletion, moves every following entry that may sit in the freed slot
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (slots[j].value == npos) {
+            break;
+        }
+        size_t home = hash(slots[j].key) & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            slots[i] = slots[j];
+            i = j;
+        }
+    }
+    slots[i].value = npos;
+    count--;
+    return true;
+}
+
+void NodeIndex::reserve(size_t count) {
+    size_t capacity = 16;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    if (capacity > slots.size()) {
+        rehash(capacity);
+    }
+}
+
+void NodeIndex::clear() {
+    slots.clear();
+    count = 0;
+}
+
+// mixes both node ids of the normalized edge key into one hash
+size_t Graph::EdgeKeyHash::operator()(const EdgeKey& key) const {
+    size_t hash = key.lo * 0x9E3779B97F4A7C15ULL;
+    hash ^= key.hi + 0x7F4A7C159E3779B9ULL + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+// removes one neighbor slot from the adjacency list, order is not preserved
+void Graph::eraseNeighbor(std::vector<size_t>& neighbors, size_t neighbor) {
+    auto i = std::find(neighbors.begin(), neighbors.end(), neighbor);
+    if (i != neighbors.end()) {
+        *i = neighbors.back();
+        neighbors.pop_back();
+    }
+}
+
+// moves one node between degree histogram buckets, the maximum only ever drops by the emptied buckets
+void Graph::moveDegree(size_t from, size_t to) {
+    degreeHistogram[from]--;
+    if (to >= degreeHistogram.size()) {
+        degreeHistogram.resize(to + 1, 0);
+    }
+    degreeHistogram[to]++;
+
+    if (to > maxDegree) {
+        maxDegree = to;
+    }
+    while (maxDegree > 0 && degreeHistogram[maxDegree] == 0) {
+        maxDegree--;
+    }
+}
+
+// removes the edge at the given position by moving the last edge in its place
+void Graph::eraseEdgeAt(size_t position) {
+    edgeIndex.erase(makeEdgeKey(graphEdges[position].a, graphEdges[position].b));
+
+    if (position != graphEdges.size() - 1) {
+        graphEdges[position] = graphEdges.back();
+        edgeIndex[makeEdgeKey(graphEdges[position].a, graphEdges[position].b)] = position;
+    }
+    graphEdges.pop_back();
+}
+
 // constructor
 Graph::Graph() {
     graphNodes.clear(); // clears the vector containing nodes
@@ -39,19 +213,25 @@ std::vector<Edge> Graph::edges() const {
 
 // adds a node to the graph
 Node* Graph::addNode(size_t nodeId) {
-    // checks if the node already exists
-    for (auto node : graphNodes) {
-        // if the node exists return null pointer
-        if (node->id == nodeId) {
-            return nullptr;
-        }
+    // checks if the node already exists, if so returns null pointer
+    if (!nodeIndex.insert(nodeId, graphNodes.size())) {
+        return nullptr;
     }
 
     // creates node and adds it to the graphNode vector
-    Node *newNode = new Node;
+    Node *newNode = nodeArena.allocate();
     if (newNode != nullptr) {
         newNode->id = nodeId;
+        newNode->color = 0;
         graphNodes.push_back(newNode);
+        adjacency.emplace_back();
+        if (degreeHistogram.empty()) {
+            degreeHistogram.push_back(0);
+        }
+        degreeHistogram[0]++;
+        if (incrementalColoring) {
+            setTrackedColor(graphNodes.size() - 1, 1);
+        }
         return newNode;
     }
     
@@ -66,80 +246,278 @@ bool Graph::addEdge(const Edge& edge) {
     }
 
     // checks if the edge already exists
-    for(auto graphEdge : graphEdges) {
-        if(graphEdge == edge) {
-            return false;
-        }
-    }    
+    EdgeKey key = makeEdgeKey(edge.a, edge.b);
+    if(edgeIndex.find(key) != edgeIndex.end()) {
+        return false;
+    }
 
     // adds the edges to the graphEdges vector
     addNode(edge.a);
     addNode(edge.b);
+    edgeIndex.emplace(key, graphEdges.size());
     graphEdges.push_back(edge);
+    size_t slotA = slotOf(edge.a);
+    size_t slotB = slotOf(edge.b);
+    auto& neighborsA = adjacency[slotA];
+    auto& neighborsB = adjacency[slotB];
+    neighborsA.push_back(slotB);
+    neighborsB.push_back(slotA);
+    moveDegree(neighborsA.size() - 1, neighborsA.size());
+    moveDegree(neighborsB.size() - 1, neighborsB.size());
+
+    if (incrementalColoring) {
+        repairColoring(edge);
+    }
 
     return true;
 }
 
 // adds multiple edges to the graph
 void Graph::addMultipleEdges(const std::vector<Edge>& edges) {
-    for(auto newEdge : edges) {
-        addEdge(newEdge);
+    addMultipleEdges(edges, 1);
+}
+
+// normalizes the edges and drops self-loops, the rest is done by the bulk path
+void Graph::addMultipleEdges(const std::vector<Edge>& edges, size_t threadCount) {
+    std::vector<EdgeKey> keys;
+    keys.reserve(edges.size());
+    for(auto& edge : edges) {
+        if(edge.a != edge.b) {
+            keys.push_back(makeEdgeKey(edge.a, edge.b));
+        }
     }
+    addEdgeKeys(keys, threadCount);
 }
 
-// returns a pointer to the node
-Node* Graph::getNode(size_t nodeId) {
-    for (auto node : graphNodes) {
-        if (node->id == nodeId) {
-            return node;
+void Graph::radixSort(EdgeKey* first, EdgeKey* last, EdgeKey* buffer) {
+    const size_t RADIX = 1 << 16;
+    size_t count = last - first;
+
+    // small ranges are not worth the histogram passes
+    if(count < RADIX) {
+        std::sort(first, last);
+        return;
+    }
+
+    // digit 0 is the least significant 16 bits of hi, digit 7 the most significant bits of lo
+    auto digit = [](const EdgeKey& key, size_t pass) {
+        uint64_t word = pass < 4 ? key.hi : key.lo;
+        return static_cast<size_t>((word >> ((pass % 4) * 16)) & 0xFFFF);
+    };
+
+    std::vector<size_t> histogram(8 * RADIX, 0);
+    for(EdgeKey* key = first; key != last; key++) {
+        for(size_t pass = 0; pass < 8; pass++) {
+            histogram[pass * RADIX + digit(*key, pass)]++;
         }
     }
-    return nullptr;
+
+    EdgeKey* source = first;
+    EdgeKey* target = buffer;
+    for(size_t pass = 0; pass < 8; pass++) {
+        size_t* bucket = &histogram[pass * RADIX];
+        if(bucket[digit(*source, pass)] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for(size_t i = 0; i < RADIX; i++) {
+            size_t size = bucket[i];
+            bucket[i] = offset;
+            offset += size;
+        }
+        for(size_t i = 0; i < count; i++) {
+            target[bucket[digit(source[i], pass)]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+
+    if(source != first) {
+        std::copy(source, source + count, first);
+    }
+}
+
+void Graph::sortEdgeKeys(std::vector<EdgeKey>& keys, size_t threadCount) {
+    std::vector<EdgeKey> buffer(keys.size());
+    threadCount = std::max<size_t>(1, std::min(threadCount, keys.size()));
+
+    std::vector<size_t> bounds(threadCount + 1);
+    for(size_t t = 0; t <= threadCount; t++) {
+        bounds[t] = keys.size() * t / threadCount;
+    }
+    parallelFor(threadCount, threadCount, [&](size_t begin, size_t end, size_t) {
+        for(size_t part = begin; part < end; part++) {
+            radixSort(keys.data() + bounds[part], keys.data() + bounds[part + 1], buffer.data() + bounds[part]);
+        }
+    });
+
+    // merges neighboring sorted parts pairwise, every level halves the number of parts
+    for(size_t width = 1; width < threadCount; width *= 2) {
+        size_t merges = (threadCount + 2 * width - 1) / (2 * width);
+        parallelFor(merges, merges, [&](size_t begin, size_t end, size_t) {
+            for(size_t merge = begin; merge < end; merge++) {
+                size_t left = merge * 2 * width;
+                size_t middle = std::min(left + width, threadCount);
+                size_t right = std::min(left + 2 * width, threadCount);
+                if(middle < right) {
+                    std::merge(keys.begin() + bounds[left], keys.begin() + bounds[middle],
+                               keys.begin() + bounds[middle], keys.begin() + bounds[right],
+                               buffer.begin() + bounds[left]);
+                    std::copy(buffer.begin() + bounds[left], buffer.begin() + bounds[right],
+                              keys.begin() + bounds[left]);
+                }
+            }
+        });
+    }
+}
+
+void Graph::addEdgeKeys(std::vector<EdgeKey>& keys, size_t threadCount) {
+    sortEdgeKeys(keys, threadCount);
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    // drops edges that are already in the graph
+    if(!graphEdges.empty()) {
+        keys.erase(std::remove_if(keys.begin(), keys.end(), [this](const EdgeKey& key) {
+            return edgeIndex.find(key) != edgeIndex.end();
+        }), keys.end());
+    }
+    if(keys.empty()) {
+        return;
+    }
+
+    // adds missing nodes and resolves the slots of both endpoints once, keys are sorted so
+    // runs of the same lower endpoint reuse its slot
+    auto slotFor = [this](size_t nodeId) {
+        size_t slot = slotOf(nodeId);
+        if(slot == NodeIndex::npos) {
+            addNode(nodeId);
+            slot = graphNodes.size() - 1;
+        }
+        return slot;
+    };
+    nodeIndex.reserve(graphNodes.size() + 2 * keys.size());
+    std::vector<std::pair<size_t, size_t>> slots(keys.size());
+    for(size_t i = 0; i < keys.size(); i++) {
+        slots[i].first = i > 0 && keys[i].lo == keys[i - 1].lo ? slots[i - 1].first : slotFor(keys[i].lo);
+        slots[i].second = slotFor(keys[i].hi);
+    }
+
+    // collects the touched slots from the batch itself, so a small batch costs nothing per graph node
+    std::vector<size_t> touched;
+    touched.reserve(2 * slots.size());
+    for(auto& slot : slots) {
+        touched.push_back(slot.first);
+        touched.push_back(slot.second);
+    }
+    std::sort(touched.begin(), touched.end());
+
+    // grows every touched adjacency list once and moves its node to the final degree bucket, capacity
+    // at least doubles so that many small batches keep the amortized cost of push_back
+    for(size_t i = 0; i < touched.size();) {
+        size_t slot = touched[i];
+        size_t end = i;
+        while(end < touched.size() && touched[end] == slot) {
+            end++;
+        }
+        size_t degree = adjacency[slot].size();
+        size_t needed = degree + (end - i);
+        if(adjacency[slot].capacity() < needed) {
+            adjacency[slot].reserve(std::max(needed, 2 * adjacency[slot].capacity()));
+        }
+        moveDegree(degree, needed);
+        i = end;
+    }
+
+    size_t edgeTotal = graphEdges.size() + keys.size();
+    if(graphEdges.capacity() < edgeTotal) {
+        graphEdges.reserve(std::max(edgeTotal, 2 * graphEdges.capacity()));
+    }
+    if(edgeTotal > edgeIndex.bucket_count() * edgeIndex.max_load_factor()) {
+        edgeIndex.reserve(std::max(edgeTotal, 2 * edgeIndex.size()));
+    }
+    for(size_t i = 0; i < keys.size(); i++) {
+        edgeIndex.emplace(keys[i], graphEdges.size());
+        graphEdges.emplace_back(keys[i].lo, keys[i].hi);
+        adjacency[slots[i].first].push_back(slots[i].second);
+        adjacency[slots[i].second].push_back(slots[i].first);
+    }
+
+    if(incrementalColoring) {
+        for(auto& key : keys) {
+            repairColoring(Edge(key.lo, key.hi));
+        }
+    }
+}
+
+// returns a pointer to the node
+Node* Graph::getNode(size_t nodeId) {
+    size_t slot = slotOf(nodeId);
+    return slot != NodeIndex::npos ? graphNodes[slot] : nullptr;
 }
 
 // checks if graph contains the given edge
 bool Graph::containsEdge(const Edge& edge) const {
-    for(auto graphEdge : graphEdges) {
-        if(graphEdge == edge) {
-            return true;
-        }
-    }  
-    return false;
+    return edgeIndex.find(makeEdgeKey(edge.a, edge.b)) != edgeIndex.end();
 }
 
 // removes the node from the graph
 void Graph::removeNode(size_t nodeId) {
-    // removes edges connected to the node
-    auto i = std::remove_if(graphEdges.begin(), graphEdges.end(), 
-        [nodeId](const Edge& edge) { 
-            return edge.a == nodeId || edge.b == nodeId; 
-        });
-    graphEdges.erase(i, graphEdges.end());
-
-    // removes the node from the node vectors and deallocates memory
-    auto nodeIt = std::find_if(graphNodes.begin(), graphNodes.end(), 
-        [nodeId](const Node* node) { 
-            return node->id == nodeId; 
-        });
+    size_t slot = slotOf(nodeId);
+    if (slot == NodeIndex::npos) {
+        throw std::out_of_range("Node does not exist!\n");
+    }
 
+    // removes edges connected to the node, only its neighbors are visited
+    for (auto neighbor : adjacency[slot]) {
+        auto& neighbors = adjacency[neighbor];
+        eraseNeighbor(neighbors, slot);
+        moveDegree(neighbors.size() + 1, neighbors.size());
+        eraseEdgeAt(edgeIndex[makeEdgeKey(nodeId, graphNodes[neighbor]->id)]);
+    }
+    degreeHistogram[adjacency[slot].size()]--;
+    while (maxDegree > 0 && degreeHistogram[maxDegree] == 0) {
+        maxDegree--;
+    }
+    if (incrementalColoring) {
+        setTrackedColor(slot, 0);
+    }
 
-    if (nodeIt != graphNodes.end()) {
-        delete *nodeIt;
-        graphNodes.erase(nodeIt);
-    } else {
-        throw std::out_of_range("Node does not exist!\n");
+    // returns the node to the arena and moves the last node into its slot, so slots stay dense
+    nodeArena.release(graphNodes[slot]);
+    nodeIndex.erase(nodeId);
+    size_t last = graphNodes.size() - 1;
+    if (slot != last) {
+        graphNodes[slot] = graphNodes[last];
+        adjacency[slot] = std::move(adjacency[last]);
+        nodeIndex.assign(graphNodes[slot]->id, slot);
+
+        // the neighbors of the moved node still refer to its old slot
+        for (auto neighbor : adjacency[slot]) {
+            auto& neighbors = adjacency[neighbor];
+            *std::find(neighbors.begin(), neighbors.end(), last) = slot;
+        }
     }
+    graphNodes.pop_back();
+    adjacency.pop_back();
 }
 
 // removes the edge from the graph
 void Graph::removeEdge(const Edge& edge) {
-    // iterates through edges and erases the given edge
-    auto i = std::find(graphEdges.begin(), graphEdges.end(), edge);
-    if (i != graphEdges.end()) {
-        graphEdges.erase(i);
-    } else {
+    // looks up the edge and erases it from the edge vector and both adjacency lists
+    auto i = edgeIndex.find(makeEdgeKey(edge.a, edge.b));
+    if (i == edgeIndex.end()) {
         throw std::out_of_range("Edge does not exist!\n");
     }
+
+    eraseEdgeAt(i->second);
+    size_t slotA = slotOf(edge.a);
+    size_t slotB = slotOf(edge.b);
+    auto& neighborsA = adjacency[slotA];
+    auto& neighborsB = adjacency[slotB];
+    eraseNeighbor(neighborsA, slotB);
+    eraseNeighbor(neighborsB, slotA);
+    moveDegree(neighborsA.size() + 1, neighborsA.size());
+    moveDegree(neighborsB.size() + 1, neighborsB.size());
 }
 
 // returns the node count
@@ -152,75 +530,425 @@ size_t Graph::edgeCount() const{
     return graphEdges.size();
 }
 
+// returns a view translating the neighbor slots of a node to ids
+NeighborIds Graph::neighbors(size_t nodeId) const {
+    size_t slot = slotOf(nodeId);
+    if (slot == NodeIndex::npos) {
+        throw std::out_of_range("Node does not exist!\n");
+    }
+
+    return NeighborIds(neighborsAt(slot), graphNodes.data());
+}
+
 // returns the degree of a node
 size_t Graph::nodeDegree(size_t nodeId) const {
     // checks if the node exists
-    if (std::find_if(graphNodes.begin(), graphNodes.end(), 
-        [nodeId](const Node* node) { return node->id == nodeId; }) == graphNodes.end()) {
+    size_t slot = slotOf(nodeId);
+    if (slot == NodeIndex::npos) {
         throw std::out_of_range("Node does not exist!\n");
     }
 
-    // counts the number of edges connected to the node
-    size_t degree = 0;
-    for (auto node : graphNodes) {
-        if (containsEdge({nodeId, node->id})) {
-            degree++;
+    // the degree is the length of the adjacency list
+    return adjacency[slot].size();
+}
+
+// returns the maximum degree of any node in the graph, kept up to date by the degree histogram
+size_t Graph::graphDegree() const{
+    return maxDegree;
+}
+
+// greedy coloring in insertion order, every node takes the lowest color unused by its neighbors
+void Graph::coloring() {
+    coloring(ColoringStrategy::InsertionOrder);
+}
+
+size_t Graph::coloring(ColoringStrategy strategy) {
+    size_t colorCount = 0;
+    switch(strategy) {
+        case ColoringStrategy::LargestFirst:
+            colorCount = colorInOrder(largestFirstOrder());
+            break;
+        case ColoringStrategy::SmallestLast:
+            colorCount = colorInOrder(smallestLastOrder());
+            break;
+        case ColoringStrategy::DSatur:
+            colorCount = colorDSatur();
+            break;
+        case ColoringStrategy::InsertionOrder:
+        default: {
+            std::vector<size_t> order(graphNodes.size());
+            for(size_t slot = 0; slot < order.size(); slot++) {
+                order[slot] = slot;
+            }
+            colorCount = colorInOrder(order);
+            break;
         }
     }
 
-    return degree;
+    if(incrementalColoring) {
+        trackColors();
+    }
+    return colorCount;
 }
 
-// returns the maximum degree of any node in the graph
-size_t Graph::graphDegree() const{
-    size_t maxDegree = 0;
+size_t Graph::colorInOrder(const std::vector<size_t>& order) {
+    // initializes all nodes with color -1
+    std::vector<size_t> colors(graphNodes.size(), -1);
 
-    // iterates through all nodes and find the max degree
-    for(auto node : graphNodes) {
-        size_t currentDegree = nodeDegree(node->id);
-        if(currentDegree > maxDegree) {
-            maxDegree = currentDegree;
+    ColorMask mask;
+    mask.reset(graphDegree() + 1);
+    size_t colorCount = 0;
+    for(auto slot : order) {
+        colorCount = std::max(colorCount, assignFirstFreeColor(slot, mask, colors));
+    }
+    storeColors(colors);
+    return colorCount;
+}
+
+// copies colors computed in a flat array indexed by slot to the nodes
+void Graph::storeColors(const std::vector<size_t>& colors) {
+    for(size_t slot = 0; slot < graphNodes.size(); slot++) {
+        graphNodes[slot]->color = colors[slot];
+    }
+}
+
+// counting sort of slots by degree, highest degree first
+std::vector<size_t> Graph::largestFirstOrder() const {
+    std::vector<size_t> start(graphDegree() + 2, 0);
+    for(auto& neighbors : adjacency) {
+        start[graphDegree() - neighbors.size() + 1]++;
+    }
+    for(size_t i = 1; i < start.size(); i++) {
+        start[i] += start[i - 1];
+    }
+
+    std::vector<size_t> order(graphNodes.size());
+    for(size_t slot = 0; slot < adjacency.size(); slot++) {
+        order[start[graphDegree() - adjacency[slot].size()]++] = slot;
+    }
+    return order;
+}
+
+// repeatedly removes a node of minimal remaining degree, nodes are kept in an array bucketed by degree
+// (Batagelj–Zaveršnik) so every removal and degree decrement is O(1)
+std::vector<size_t> Graph::smallestLastOrder() const {
+    size_t count = graphNodes.size();
+    std::vector<size_t> degree(count);
+    std::vector<size_t> bucketStart(graphDegree() + 1, 0);
+    for(size_t slot = 0; slot < count; slot++) {
+        degree[slot] = adjacency[slot].size();
+        bucketStart[degree[slot]]++;
+    }
+
+    size_t offset = 0;
+    for(auto& start : bucketStart) {
+        size_t size = start;
+        start = offset;
+        offset += size;
+    }
+
+    // sorted holds slots ordered by remaining degree, position is the inverse permutation
+    std::vector<size_t> sorted(count);
+    std::vector<size_t> position(count);
+    for(size_t slot = 0; slot < count; slot++) {
+        position[slot] = bucketStart[degree[slot]]++;
+        sorted[position[slot]] = slot;
+    }
+    for(size_t d = bucketStart.size() - 1; d > 0; d--) {
+        bucketStart[d] = bucketStart[d - 1];
+    }
+    if(!bucketStart.empty()) {
+        bucketStart[0] = 0;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        size_t slot = sorted[i];
+        for(auto neighbor : adjacency[slot]) {
+            if(degree[neighbor] > degree[slot]) {
+                // swaps the neighbor with the first node of its bucket and shrinks the bucket
+                size_t neighborDegree = degree[neighbor];
+                size_t first = bucketStart[neighborDegree];
+                size_t other = sorted[first];
+                if(other != neighbor) {
+                    std::swap(sorted[position[neighbor]], sorted[first]);
+                    position[other] = position[neighbor];
+                    position[neighbor] = first;
+                }
+                bucketStart[neighborDegree]++;
+                degree[neighbor]--;
+            }
         }
     }
 
-    return maxDegree;
+    // nodes removed last are colored first
+    std::reverse(sorted.begin(), sorted.end());
+    return sorted;
 }
 
-void Graph::coloring() {
-    // initializes all nodes with color -1
+// Jones–Plassmann over a read-only CSR snapshot of the adjacency, every round colors the nodes whose
+// higher priority neighbors are all colored and releases the neighbors that were waiting only for them
+size_t Graph::parallelColoring(size_t threadCount, uint64_t seed) {
+    size_t count = graphNodes.size();
+    std::vector<size_t> offsets(count + 1, 0);
+    for(size_t slot = 0; slot < count; slot++) {
+        offsets[slot + 1] = offsets[slot] + adjacency[slot].size();
+    }
+    std::vector<size_t> neighbors(offsets[count]);
+    std::vector<uint64_t> priority(count);
+    for(size_t slot = 0; slot < count; slot++) {
+        std::copy(adjacency[slot].begin(), adjacency[slot].end(), neighbors.begin() + offsets[slot]);
+
+        uint64_t x = graphNodes[slot]->id ^ (seed * 0x9E3779B97F4A7C15ULL);
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        priority[slot] = x ^ (x >> 31);
+    }
+
+    // ties of the random priority are broken by node id so the order is total
+    auto before = [&](size_t a, size_t b) {
+        return priority[a] != priority[b] ? priority[a] > priority[b] : graphNodes[a]->id > graphNodes[b]->id;
+    };
+
+    std::vector<std::atomic<size_t>> waiting(count);
+    std::vector<size_t> colors(count, 0);
+    std::vector<std::vector<size_t>> ready(std::max<size_t>(threadCount, 1));
+
+    parallelFor(count, threadCount, [&](size_t begin, size_t end, size_t thread) {
+        for(size_t slot = begin; slot < end; slot++) {
+            size_t higher = 0;
+            for(size_t i = offsets[slot]; i < offsets[slot + 1]; i++) {
+                higher += before(neighbors[i], slot);
+            }
+            waiting[slot].store(higher, std::memory_order_relaxed);
+            if(higher == 0) {
+                ready[thread].push_back(slot);
+            }
+        }
+    });
+
+    std::vector<size_t> round;
+    std::vector<std::vector<size_t>> next(ready.size());
+    std::vector<size_t> threadColors(ready.size(), 0);
+    size_t maxColor = graphDegree() + 1;
+    while(true) {
+        round.clear();
+        for(auto& part : ready) {
+            round.insert(round.end(), part.begin(), part.end());
+            part.clear();
+        }
+        if(round.empty()) {
+            break;
+        }
+
+        parallelFor(round.size(), threadCount, [&](size_t begin, size_t end, size_t thread) {
+            ColorMask mask;
+            mask.reset(maxColor);
+            for(size_t r = begin; r < end; r++) {
+                size_t slot = round[r];
+                for(size_t i = offsets[slot]; i < offsets[slot + 1]; i++) {
+                    if(before(neighbors[i], slot)) {
+                        mask.forbid(colors[neighbors[i]]);
+                    }
+                }
+                size_t color = mask.firstFree();
+                for(size_t i = offsets[slot]; i < offsets[slot + 1]; i++) {
+                    if(before(neighbors[i], slot)) {
+                        mask.allow(colors[neighbors[i]]);
+                    }
+                }
+                colors[slot] = color;
+                threadColors[thread] = std::max(threadColors[thread], color);
+
+                for(size_t i = offsets[slot]; i < offsets[slot + 1]; i++) {
+                    size_t neighbor = neighbors[i];
+                    if(before(slot, neighbor) && waiting[neighbor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        next[thread].push_back(neighbor);
+                    }
+                }
+            }
+        });
+        ready.swap(next);
+    }
+
+    storeColors(colors);
+    if(incrementalColoring) {
+        trackColors();
+    }
+    return count == 0 ? 0 : *std::max_element(threadColors.begin(), threadColors.end());
+}
+
+void Graph::setIncrementalColoring(bool enabled, size_t maxColorDrift, ColoringStrategy strategy) {
+    colorDriftLimit = maxColorDrift;
+    recolorStrategy = strategy;
+    incrementalColoring = enabled;
+    if(enabled) {
+        coloring(strategy);
+    } else {
+        colorHistogram.clear();
+        colorsInUse = 0;
+    }
+}
+
+size_t Graph::colorCount() const {
+    if(incrementalColoring) {
+        return colorsInUse;
+    }
+
+    size_t maxColor = 0;
     for(auto node : graphNodes) {
-        node->color = -1;
+        if(node->color != static_cast<size_t>(-1)) {
+            maxColor = std::max(maxColor, node->color);
+        }
     }
+    return maxColor;
+}
 
-    // generates a list of colors
-    std::vector<size_t> colors;
-    for(size_t i = 1; i <= graphDegree() + 1; i++) {
-        colors.push_back(i);
+void Graph::trackColors() {
+    colorHistogram.assign(graphDegree() + 2, 0);
+    colorsInUse = 0;
+    for(auto node : graphNodes) {
+        colorHistogram[node->color]++;
+        colorsInUse = std::max(colorsInUse, node->color);
     }
+    baselineColors = colorsInUse;
+}
 
-    // iterates through all nodes and assign colors
-    for(auto nodeI : graphNodes) {
-        std::vector<size_t> tempColors = colors;
+// color 0 stands for a removed node and is not counted
+void Graph::setTrackedColor(size_t slot, size_t color) {
+    size_t old = graphNodes[slot]->color;
+    if(old != 0 && old < colorHistogram.size()) {
+        colorHistogram[old]--;
+    }
 
-        for(auto nodeJ : graphNodes) {
-            if(containsEdge({nodeI->id, nodeJ->id})) {
-                auto i = std::find(tempColors.begin(), tempColors.end(), nodeJ->color);
-                if(i != tempColors.end()) {
-                    tempColors.erase(i);
+    graphNodes[slot]->color = color;
+    if(color != 0) {
+        if(color >= colorHistogram.size()) {
+            colorHistogram.resize(color + 1, 0);
+        }
+        colorHistogram[color]++;
+        colorsInUse = std::max(colorsInUse, color);
+    }
+    while(colorsInUse > 0 && colorHistogram[colorsInUse] == 0) {
+        colorsInUse--;
+    }
+}
+
+// recolors the endpoint with fewer neighbors, its new color is at most its degree + 1
+void Graph::repairColoring(const Edge& edge) {
+    size_t slotA = slotOf(edge.a);
+    size_t slotB = slotOf(edge.b);
+    if(graphNodes[slotA]->color != graphNodes[slotB]->color) {
+        return;
+    }
+
+    size_t slot = adjacency[slotA].size() <= adjacency[slotB].size() ? slotA : slotB;
+    recolorMask.reset(adjacency[slot].size() + 1);
+    for(auto neighbor : adjacency[slot]) {
+        recolorMask.forbid(graphNodes[neighbor]->color);
+    }
+    setTrackedColor(slot, recolorMask.firstFree());
+
+    if(colorDriftLimit != static_cast<size_t>(-1) && colorsInUse > baselineColors + colorDriftLimit) {
+        coloring(recolorStrategy);
+    }
+}
+
+// DSatur with a lazy max-heap, an entry is skipped when the node was colored or its saturation grew since the push
+size_t Graph::colorDSatur() {
+    size_t count = graphNodes.size();
+    std::vector<size_t> colors(count, -1);
+
+    // distinct neighbor colors of every node up to its degree + 1 are kept in one flat bitmap,
+    // higher colors are rare and deduplicated in a small per-node list
+    std::vector<size_t> bitmapOffset(count + 1, 0);
+    for(size_t slot = 0; slot < count; slot++) {
+        bitmapOffset[slot + 1] = bitmapOffset[slot] + (adjacency[slot].size() + 2) / 64 + 1;
+    }
+    std::vector<uint64_t> neighborColors(bitmapOffset[count], 0);
+    std::vector<std::vector<size_t>> highColors(count);
+    std::vector<size_t> saturation(count, 0);
+
+    typedef std::tuple<size_t, size_t, size_t> Entry;  // saturation, degree, inverted slot
+    std::priority_queue<Entry> queue;
+    for(size_t slot = 0; slot < count; slot++) {
+        queue.emplace(0, adjacency[slot].size(), count - slot);
+    }
+
+    ColorMask mask;
+    mask.reset(graphDegree() + 1);
+    size_t colorCount = 0;
+    while(!queue.empty()) {
+        Entry entry = queue.top();
+        queue.pop();
+        size_t slot = count - std::get<2>(entry);
+        if(colors[slot] != static_cast<size_t>(-1) || std::get<0>(entry) != saturation[slot]) {
+            continue;
+        }
+
+        size_t color = assignFirstFreeColor(slot, mask, colors);
+        colorCount = std::max(colorCount, color);
+
+        for(auto neighbor : adjacency[slot]) {
+            if(colors[neighbor] != static_cast<size_t>(-1)) {
+                continue;
+            }
+
+            bool isNew = false;
+            if(color <= adjacency[neighbor].size() + 1) {
+                uint64_t& word = neighborColors[bitmapOffset[neighbor] + color / 64];
+                uint64_t bit = uint64_t(1) << (color % 64);
+                isNew = (word & bit) == 0;
+                word |= bit;
+            } else {
+                auto& high = highColors[neighbor];
+                isNew = std::find(high.begin(), high.end(), color) == high.end();
+                if(isNew) {
+                    high.push_back(color);
                 }
             }
+
+            if(isNew) {
+                saturation[neighbor]++;
+                queue.emplace(saturation[neighbor], adjacency[neighbor].size(), count - neighbor);
+            }
         }
-        
-        nodeI->color = tempColors[0];
     }
+
+    storeColors(colors);
+    return colorCount;
+}
+
+size_t Graph::assignFirstFreeColor(size_t slot, ColorMask& mask, std::vector<size_t>& colors) {
+    auto& neighbors = adjacency[slot];
+
+    // marks colors of the neighbors, uncolored neighbors fall outside of the mask
+    for(auto neighbor : neighbors) {
+        mask.forbid(colors[neighbor]);
+    }
+
+    size_t color = mask.firstFree();
+    colors[slot] = color;
+
+    // clears only the bits set above so the mask can be reused for the next node
+    for(auto neighbor : neighbors) {
+        mask.allow(colors[neighbor]);
+    }
+
+    return color;
 }
 
 // clears graph
 void Graph::clear() {
-graphEdges.clear();         // clears edges vector
-    for(auto node : graphNodes) {
-        delete node;            // deallocates memory for each node            
-    }
+    graphEdges.clear();         // clears edges vector
+    edgeIndex.clear();          // clears edge lookup table
+    adjacency.clear();          // clears adjacency lists
+    nodeIndex.clear();          // clears node lookup table
+    degreeHistogram.clear();    // clears degree statistics
+    maxDegree = 0;
+    colorHistogram.clear();     // clears color statistics
+    colorsInUse = 0;
+    baselineColors = 0;
     graphNodes.clear();         // clears nodes vector
+    nodeArena.clear();          // deallocates memory of all nodes at once
 }
 /*** Konec souboru tdd_code.cpp ***/
@@ -25,6 +25,12 @@
 // Místo pro Vaše případné includy, používejte pouze standardní knihovnu tak, aby nebylo nutno upravovat CMake.
 
 #include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
 
 /**
  * @brief reprezentace uzlu
@@ -82,12 +88,406 @@ public:
     }
 };
 
+/**
+ * @brief Hašovací tabulka s otevřeným adresováním, která mapuje id uzlu na jeho pozici v grafu.
+ *
+ * Používá lineární zkoušení nad tabulkou o velikosti mocniny dvou a při mazání posouvá následující
+ * položky zpět, takže nepotřebuje náhrobky (tombstones).
+ */
+class NodeIndex{
+public:
+    static const size_t npos = static_cast<size_t>(-1);  ///< hodnota vrácená pro chybějící klíč
+
+    /**
+     * @brief Vyhledá pozici uzlu.
+     * @param[in] key id uzlu
+     * @return pozice uzlu nebo npos, pokud klíč v tabulce není
+     */
+    size_t find(size_t key) const;
+
+    /**
+     * @brief Vloží nový klíč.
+     * @param[in] key id uzlu
+     * @param[in] value pozice uzlu
+     * @return true pokud byl klíč vložen, false pokud již v tabulce existuje
+     */
+    bool insert(size_t key, size_t value);
+
+    /**
+     * @brief Změní hodnotu existujícího klíče.
+     * @param[in] key id uzlu
+     * @param[in] value nová pozice uzlu
+     */
+    void assign(size_t key, size_t value);
+
+    /**
+     * @brief Odstraní klíč z tabulky.
+     * @param[in] key id uzlu
+     * @return true pokud byl klíč odstraněn, jinak false
+     */
+    bool erase(size_t key);
+
+    /**
+     * @brief Připraví tabulku na daný počet klíčů bez další realokace.
+     * @param[in] count očekávaný počet klíčů
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Odstraní všechny klíče.
+     */
+    void clear();
+
+    /**
+     * @return počet klíčů v tabulce
+     */
+    size_t size() const { return count; }
+
+private:
+    struct Slot{
+        size_t key;
+        size_t value;  ///< npos značí prázdnou položku
+    };
+
+    static size_t hash(size_t key);
+    size_t probe(size_t key) const;
+    void rehash(size_t newCapacity);
+
+    std::vector<Slot> slots;
+    size_t count = 0;
+};
+
+/**
+ * @brief Spočítá nulové bity za nejnižším nastaveným bitem.
+ * @param[in] word nenulové slovo
+ * @return pozice nejnižšího nastaveného bitu
+ */
+inline size_t countTrailingZeros(uint64_t word){
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_ctzll(word));
+#else
+    size_t count = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Spočítá nastavené bity ve slově.
+ * @param[in] word slovo
+ * @return počet nastavených bitů
+ */
+inline size_t countSetBits(uint64_t word){
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_popcountll(word));
+#else
+    size_t count = 0;
+    for (; word != 0; word &= word - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Nevlastnící pohled na souvislé pole prvků.
+ *
+ * Pohled neprovádí kopii, platí jen po dobu existence a beze změny pole, do kterého ukazuje.
+ */
+template<typename T>
+class Span{
+public:
+    typedef const T* iterator;  ///< iterátor přes prvky pohledu
+
+    Span() : first(nullptr), count(0) { }
+
+    /**
+     * @param[in] data ukazatel na první prvek
+     * @param[in] size počet prvků
+     */
+    Span(const T* data, size_t size) : first(data), count(size) { }
+
+    iterator begin() const { return first; }
+    iterator end() const { return first + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t i) const { return first[i]; }
+
+private:
+    const T* first;
+    size_t count;
+};
+
+/**
+ * @brief Pohled na id sousedů uzlu.
+ *
+ * Seznamy sousedů obsahují husté indexy uzlů, pohled je při průchodu převádí na id bez kopírování.
+ * Platí stejně jako Span, dokud se graf nezmění.
+ */
+class NeighborIds{
+public:
+    /**
+     * @brief Iterátor vracející id souseda.
+     */
+    class iterator{
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef size_t value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const size_t* pointer;
+        typedef size_t reference;
+
+        iterator(const size_t* index, Node* const* nodes) : index(index), nodes(nodes) { }
+
+        size_t operator*() const { return nodes[*index]->id; }
+        iterator& operator++() { index++; return *this; }
+        iterator operator++(int) { iterator old = *this; index++; return old; }
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+
+    private:
+        const size_t* index;
+        Node* const* nodes;
+    };
+
+    typedef iterator const_iterator;
+    typedef size_t value_type;
+
+    /**
+     * @param[in] indices husté indexy sousedů
+     * @param[in] nodes uzly grafu indexované hustým indexem
+     */
+    NeighborIds(Span<size_t> indices, Node* const* nodes) : indices(indices), nodes(nodes) { }
+
+    iterator begin() const { return iterator(indices.begin(), nodes); }
+    iterator end() const { return iterator(indices.end(), nodes); }
+    size_t size() const { return indices.size(); }
+    bool empty() const { return indices.empty(); }
+    size_t operator[](size_t i) const { return nodes[indices[i]]->id; }
+
+private:
+    Span<size_t> indices;
+    Node* const* nodes;
+};
+
+/**
+ * @brief Rozdělí rozsah 0 až count na threadCount souvislých částí a zpracuje je paralelně.
+ *
+ * Poslední část zpracuje volající vlákno. Pro jedno vlákno nebo prázdný rozsah se funkce zavolá přímo.
+ *
+ * @param[in] count velikost rozsahu
+ * @param[in] threadCount počet vláken
+ * @param[in] function funkce volaná jako function(začátek, konec, index vlákna)
+ */
+template<typename Function>
+void parallelFor(size_t count, size_t threadCount, Function function){
+    if (threadCount <= 1 || count <= 1) {
+        function(size_t(0), count, size_t(0));
+        return;
+    }
+
+    threadCount = std::min(threadCount, count);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t t = 0; t + 1 < threadCount; t++) {
+        threads.emplace_back(function, count * t / threadCount, count * (t + 1) / threadCount, t);
+    }
+    function(count * (threadCount - 1) / threadCount, count, threadCount - 1);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Bitová maska barev zakázaných pro právě barvený uzel.
+ *
+ * Maska se alokuje jednou pro celé barvení. Po obarvení uzlu se zakázané barvy vrátí zpět metodou allow,
+ * takže barvení uzlu stojí O(stupeň) bez alokace.
+ */
+class ColorMask{
+public:
+    /**
+     * @brief Nastaví masku pro barvy 1 až maxColor, všechny jsou povolené.
+     * @param[in] maxColor nejvyšší použitelná barva
+     */
+    void reset(size_t maxColor){
+        words.assign(maxColor / 64 + 1, 0);
+        words[0] = 1;  // barva 0 znamená neobarveno a nikdy se nepřiřazuje
+        limit = maxColor;
+    }
+
+    /**
+     * @brief Zakáže barvu, barvy mimo rozsah masky jsou ignorovány.
+     * @param[in] color barva souseda
+     */
+    void forbid(size_t color){
+        if (color <= limit) {
+            words[color / 64] |= uint64_t(1) << (color % 64);
+        }
+    }
+
+    /**
+     * @brief Znovu povolí barvu zakázanou metodou forbid.
+     * @param[in] color barva souseda
+     */
+    void allow(size_t color){
+        if (color != 0 && color <= limit) {
+            words[color / 64] &= ~(uint64_t(1) << (color % 64));
+        }
+    }
+
+    /**
+     * @brief Povolí všechny barvy najednou bez průchodu sousedů, cena závisí jen na highest / 64.
+     * @param[in] highest nejvyšší zakázaná barva, žádná vyšší barva nesmí být zakázána
+     */
+    void allowAll(size_t highest){
+        size_t last = std::min(highest, limit) / 64;
+        std::fill(words.begin(), words.begin() + last + 1, 0);
+        words[0] = 1;
+    }
+
+    /**
+     * @return nejnižší povolená barva nebo maxColor + 1, pokud jsou všechny zakázané
+     */
+    size_t firstFree() const{
+        for (size_t i = 0; i < words.size(); i++) {
+            if (~words[i] != 0) {
+                size_t color = i * 64 + countTrailingZeros(~words[i]);
+                return color <= limit ? color : limit + 1;
+            }
+        }
+        return limit + 1;
+    }
+
+private:
+    std::vector<uint64_t> words;
+    size_t limit = 0;
+};
+
+/**
+ * @brief Alokátor uzlů po blocích.
+ *
+ * Uzly jsou alokovány v souvislých blocích po CHUNK_SIZE uzlech, takže adresa uzlu zůstává platná po celou
+ * dobu jeho existence. Uvolněné uzly se ukládají do seznamu volných míst a jsou znovu použity.
+ */
+class NodeArena{
+public:
+    static const size_t CHUNK_SIZE = 4096;  ///< počet uzlů v jednom bloku
+
+    /**
+     * @brief Vrátí místo pro nový uzel, přednostně ze seznamu volných míst.
+     * @return ukazatel na neinicializovaný uzel
+     */
+    Node* allocate();
+
+    /**
+     * @brief Vrátí uzel do seznamu volných míst.
+     * @param[in] node uzel dříve získaný metodou allocate
+     */
+    void release(Node* node);
+
+    /**
+     * @brief Uvolní najednou všechny bloky. Všechny dříve vrácené ukazatele přestávají být platné.
+     */
+    void clear();
+
+    /**
+     * @return počet alokovaných bloků
+     */
+    size_t chunkCount() const { return chunks.size(); }
+
+private:
+    std::vector<std::unique_ptr<Node[]>> chunks;
+    size_t chunkUsed = CHUNK_SIZE;  ///< počet použitých uzlů v posledním bloku
+    std::vector<Node*> freeNodes;
+};
+
+/**
+ * @brief Pořadí, ve kterém hladové barvení prochází uzly.
+ */
+enum class ColoringStrategy{
+    InsertionOrder,  ///< uzly v pořadí vložení do grafu
+    LargestFirst,    ///< Welsh–Powell, uzly sestupně podle stupně
+    SmallestLast,    ///< degenerační pořadí, uzly s nejmenším zbývajícím stupněm jsou barveny poslední
+    DSatur           ///< vždy uzel s nejvíce různými barvami sousedů, shoda se řeší stupněm
+};
+
+/**
+ * @brief Výsledek hledání optimálního obarvení.
+ */
+struct ExactColoring{
+    size_t colorCount;  ///< počet barev nejlepšího nalezeného obarvení
+    size_t lowerBound;  ///< dokázaná dolní mez chromatického čísla
+    bool optimal;       ///< true pokud prohledávání doběhlo a colorCount je chromatické číslo
+};
+
+/**
+ * @brief Přečíslování uzlů pro lepší lokalitu přístupů do paměti.
+ */
+enum class ReorderStrategy{
+    ReverseCuthillMcKee,  ///< prohledávání do šířky od uzlu nejmenšího stupně, výsledné pořadí je obrácené
+    DegreeDescending,     ///< uzly sestupně podle stupně
+    HubClustering         ///< uzly se stupněm nad průměrem napřed, jinak se pořadí zachová
+};
+
+/**
+ * @brief Průměrná mezera mezi indexy sousedních uzlů před a po přečíslování.
+ */
+struct ReorderStats{
+    double gapBefore;  ///< průměr |index(a) - index(b)| přes všechny hrany před přečíslováním
+    double gapAfter;   ///< totéž po přečíslování
+};
+
+/**
+ * @brief Implementace průniku dvou seřazených množin 32bitových indexů.
+ */
+enum class IntersectKernel{
+    Scalar,  ///< slévání po jednom prvku
+    Sse2,    ///< bloky po 4 prvcích porovnané se všemi rotacemi bloku druhé množiny
+    Avx2,    ///< bloky po 8 prvcích, použije se jen na procesoru s AVX2
+    Best     ///< nejrychlejší dostupná implementace
+};
+
+/**
+ * @param[in] kernel implementace průniku
+ * @return true pokud ji lze na tomto procesoru a v tomto sestavení použít
+ */
+bool intersectKernelAvailable(IntersectKernel kernel);
+
+/**
+ * Spočítá prvky společné dvěma vzestupně seřazeným polím bez opakování. Nedostupná implementace je
+ * nahrazena nejlepší dostupnou.
+ *
+ * @param[in] a první pole
+ * @param[in] sizeA počet prvků prvního pole
+ * @param[in] b druhé pole
+ * @param[in] sizeB počet prvků druhého pole
+ * @param[in] kernel implementace průniku
+ * @return velikost průniku
+ */
+size_t intersectSortedCount(const uint32_t* a, size_t sizeA, const uint32_t* b, size_t sizeB,
+                            IntersectKernel kernel = IntersectKernel::Best);
+
+class FrozenGraph;
+
+/**
+ * @brief Rozdělení uzlů grafu do komponent souvislosti.
+ */
+struct ComponentLabels{
+    std::vector<size_t> labels;  ///< číslo komponenty 0 až sizes.size() - 1 pro každý index uzlu
+    std::vector<size_t> sizes;   ///< počet uzlů v každé komponentě
+};
+
 /**
  * @brief Třída reprezentující neorientovaný graf bez smyček.
  *
  */
 class Graph{
 public:
+    static const size_t UNREACHED = static_cast<size_t>(-1);  ///< vzdálenost a rodič nedosaženého uzlu
 
     /**
      * @brief konstruktor prázdného grafu
@@ -109,6 +509,55 @@ public:
      */
     std::vector<Edge> edges() const;
 
+    /**
+     * Pohled na uzly bez kopírování. Pohled přestává platit po addNode, addEdge, addMultipleEdges,
+     * importEdgeList, removeNode, reorder a clear. Ukazatele na uzly zůstávají platné, dokud uzel
+     * není odstraněn.
+     *
+     * @return pohled na ukazatele na všechny uzly v grafu
+     */
+    Span<Node*> nodesView() const{
+        return Span<Node*>(graphNodes.data(), graphNodes.size());
+    }
+
+    /**
+     * Pohled na hrany bez kopírování. Pohled přestává platit po addEdge, addMultipleEdges, importEdgeList,
+     * removeEdge, removeNode, reorder a clear.
+     *
+     * @return pohled na všechny hrany v grafu
+     */
+    Span<Edge> edgesView() const{
+        return Span<Edge>(graphEdges.data(), graphEdges.size());
+    }
+
+    /**
+     * Pohled na id sousedů uzlu bez kopírování. Pohled přestává platit po jakékoliv změně grafu.
+     *
+     * @param[in] nodeId id uzlu
+     * @return pohled na id sousedních uzlů
+     * @exception out_of_range pokud uzel v grafu neexistuje
+     */
+    NeighborIds neighbors(size_t nodeId) const;
+
+    /**
+     * Pohled na indexy sousedů uzlu (viz indexOf) bez kopírování a bez převodu na id.
+     * Pohled přestává platit po jakékoliv změně grafu.
+     *
+     * @param[in] index index uzlu
+     * @return pohled na indexy sousedních uzlů
+     */
+    Span<size_t> neighborsAt(size_t index) const{
+        return Span<size_t>(adjacency[index].data(), adjacency[index].size());
+    }
+
+    /**
+     * @param[in] index index uzlu (viz indexOf)
+     * @return id uzlu
+     */
+    size_t nodeIdAt(size_t index) const{
+        return graphNodes[index]->id;
+    }
+
     /**
      * Přidá uzel s daným id do grafu a vrátí ukazatel na vytvořený uzel. Pokud uzel existuje vrátí nullptr.
      * Volající se nestárá o mazání uzlu.
@@ -135,6 +584,16 @@ public:
      */
     void addMultipleEdges(const std::vector<Edge>& edges);
 
+    /**
+     * @brief Naplní graf z vektoru hran hromadně. Hrany jsou normalizovány, seřazeny radix sortem,
+     * zbaveny duplicit a smyček a poté jsou jedním průchodem přidány uzly a seznamy sousedů.
+     * Pokud uzel definovaný hranou neexistuje, tak bude vytvořen.
+     *
+     * @param[in] edges	Vektor obsahující hrany.
+     * @param[in] threadCount počet vláken pro řazení hran
+     */
+    void addMultipleEdges(const std::vector<Edge>& edges, size_t threadCount);
+
     /**
      * @brief Vrátí ukazatel na uzel s daným id.
      * @param[in] nodeId	Id uzlu.
@@ -199,16 +658,390 @@ public:
      */
     void coloring();
 
+    /**
+     * Provede hladové obarvení uzlů v pořadí daném strategií. Obarvení je uloženo v atributu color
+     * a nikdy nepoužije více než graphDegree + 1 barev.
+     *
+     * @param[in] strategy pořadí barvení uzlů
+     * @return počet použitých barev
+     */
+    size_t coloring(ColoringStrategy strategy);
+
+    /**
+     * Provede obarvení uzlů paralelně algoritmem Jones–Plassmann. Každý uzel dostane náhodnou prioritu
+     * odvozenou z jeho id a semínka. Uzel je obarven nejnižší barvou nepoužitou sousedy s vyšší prioritou,
+     * jakmile jsou všichni tito sousedé obarveni. Výsledek tedy nezávisí na počtu vláken ani na plánování.
+     * Nepoužije více než graphDegree + 1 barev.
+     *
+     * @param[in] threadCount počet vláken
+     * @param[in] seed semínko pro priority uzlů
+     * @return počet použitých barev
+     */
+    size_t parallelColoring(size_t threadCount, uint64_t seed = 0);
+
+    /**
+     * Najde obarvení s nejmenším počtem barev metodou větví a mezí. Horní mez dává DSatur, dolní mez
+     * hladově nalezená klika, jejíž uzly dostanou pevně barvy 1 až k. Prohledávání vybírá vždy uzel
+     * s nejvíce různými barvami sousedů a pracuje nad bitovou maticí sousednosti, je určeno pro grafy
+     * do několika tisíc uzlů. Vrchol stromu prohledávání se rozdělí na podstromy, které si vlákna
+     * postupně berou. Po vypršení času zůstane v uzlech nejlepší dosud nalezené obarvení.
+     *
+     * @param[in] timeBudget časový limit v sekundách, záporná hodnota znamená bez omezení
+     * @param[in] threadCount počet vláken
+     * @return počet barev, dolní mez a zda je výsledek dokázaně optimální
+     */
+    ExactColoring optimalColoring(double timeBudget = -1, size_t threadCount = 1);
+
+    /**
+     * Obarví graf optimálně bez časového omezení, viz optimalColoring.
+     *
+     * @param[in] threadCount počet vláken
+     * @return chromatické číslo grafu
+     */
+    size_t chromaticNumber(size_t threadCount = 1);
+
+    /**
+     * Zapne nebo vypne průběžné barvení. Po zapnutí je graf obarven zvolenou strategií a obarvení zůstává
+     * platné i po addNode, addEdge, addMultipleEdges a removeNode. Při konfliktu nové hrany je přebarven
+     * jen koncový uzel s menším stupněm, a to nejnižší barvou nepoužitou jeho sousedy.
+     * Pokud počet barev vzroste o více než maxColorDrift oproti poslednímu úplnému obarvení,
+     * graf se znovu celý obarví.
+     *
+     * @param[in] enabled true pro zapnutí průběžného barvení
+     * @param[in] maxColorDrift povolený nárůst počtu barev, výchozí hodnota nárůst neomezuje
+     * @param[in] strategy strategie úplného obarvení
+     */
+    void setIncrementalColoring(bool enabled, size_t maxColorDrift = static_cast<size_t>(-1),
+                                ColoringStrategy strategy = ColoringStrategy::SmallestLast);
+
+    /**
+     * @return počet použitých barev, při průběžném barvení v O(1), jinak se spočítá z uzlů
+     */
+    size_t colorCount() const;
+
+    /**
+     * Uloží graf do binárního souboru ve formátu CSR, který lze bez načítání otevřít třídou MappedGraph.
+     * Soubor obsahuje seřazená id uzlů, začátky seznamů sousedů, seřazené seznamy sousedů a barvy uzlů.
+     *
+     * @param[in] path cesta k souboru
+     * @exception runtime_error pokud soubor nelze zapsat
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * Vytvoří neměnný snímek grafu ve formátu CSR s hustými indexy uzlů a seřazenými seznamy sousedů.
+     * Snímek lze sdílet mezi vlákny bez zámků a graf lze dál měnit. Definice je v tdd_csr_graph.h.
+     *
+     * @return snímek grafu
+     */
+    FrozenGraph freeze() const;
+
+    /**
+     * Načte hrany z textového seznamu hran (SNAP, Matrix Market). Každý řádek obsahuje dvě id uzlů oddělená
+     * bílými znaky, další sloupce jsou ignorovány. Řádky začínající znakem # nebo % jsou komentáře a
+     * u Matrix Market souboru je přeskočen řádek s rozměry. Soubor je čten po částech velikosti chunkSize,
+     * každá část je rozdělena mezi vlákna a hrany jdou rovnou do hromadného přidání, takže spotřeba paměti
+     * je úměrná chunkSize a ne velikosti souboru.
+     *
+     * @param[in] path cesta k souboru
+     * @param[in] chunkSize velikost čtené části v bajtech
+     * @param[in] threadCount počet vláken pro parsování a řazení
+     * @return počet přidaných hran
+     * @exception runtime_error pokud soubor nelze otevřít nebo obsahuje neplatný řádek
+     */
+    size_t importEdgeList(const std::string& path, size_t chunkSize = 64 << 20, size_t threadCount = 1);
+
+    /**
+     * @brief Vrátí index uzlu, tedy jeho pozici v nodes() a nodesView().
+     * Indexy se mění při removeNode, kdy poslední uzel přejde na místo odstraněného.
+     * @param[in] nodeId id uzlu
+     * @return index uzlu nebo UNREACHED, pokud uzel neexistuje
+     */
+    size_t indexOf(size_t nodeId) const{
+        return slotOf(nodeId);
+    }
+
+    /**
+     * Prohledávání do šířky z jednoho uzlu. Výsledky jsou zapsány do polí volajícího indexovaných
+     * indexem uzlu (viz indexOf), obě pole musí mít alespoň nodeCount() prvků. Nedosažené uzly mají
+     * vzdálenost i rodiče UNREACHED, počáteční uzel je svým vlastním rodičem.
+     *
+     * Prohledávání mění směr podle velikosti fronty: malé vrstvy prochází shora dolů ze seznamu uzlů,
+     * velké vrstvy zdola nahoru, kdy každý nenavštívený uzel hledá souseda v bitové mapě aktuální vrstvy.
+     * S více vlákny se vrstvy zpracovávají paralelně, vzdálenosti jsou stejné, ale rodič může být
+     * kterýkoliv soused z předchozí vrstvy.
+     *
+     * @param[in] sourceId id počátečního uzlu
+     * @param[out] distances vzdálenosti od počátečního uzlu
+     * @param[out] parents rodiče ve stromu prohledávání, může být nullptr
+     * @param[in] threadCount počet vláken
+     * @return počet dosažených uzlů
+     * @exception out_of_range pokud počáteční uzel v grafu neexistuje
+     */
+    size_t bfs(size_t sourceId, size_t* distances, size_t* parents = nullptr, size_t threadCount = 1) const;
+
+    /**
+     * Prohledávání do šířky z více uzlů zároveň, vzdálenost je měřena k nejbližšímu z nich.
+     * Ostatní vlastnosti jsou stejné jako u bfs z jednoho uzlu.
+     *
+     * @param[in] sourceIds id počátečních uzlů
+     * @param[out] distances vzdálenosti od nejbližšího počátečního uzlu
+     * @param[out] parents rodiče ve stromu prohledávání, může být nullptr
+     * @param[in] threadCount počet vláken
+     * @return počet dosažených uzlů
+     * @exception out_of_range pokud některý z počátečních uzlů v grafu neexistuje
+     */
+    size_t bfs(const std::vector<size_t>& sourceIds, size_t* distances, size_t* parents = nullptr,
+               size_t threadCount = 1) const;
+
+    /**
+     * Prohledávání do hloubky. Indexy uzlů (viz indexOf) jsou zapsány do pole volajícího v pořadí
+     * prvního navštívení, pole musí mít alespoň nodeCount() prvků.
+     *
+     * @param[in] sourceId id počátečního uzlu
+     * @param[out] order indexy navštívených uzlů
+     * @return počet navštívených uzlů
+     * @exception out_of_range pokud počáteční uzel v grafu neexistuje
+     */
+    size_t dfs(size_t sourceId, size_t* order) const;
+
+    /**
+     * Najde komponenty souvislosti pomocí union-find bez zámků. Vlákna si rozdělí uzly a spojují
+     * koncové uzly jejich hran, kořen s vyšším indexem je vždy připojen pod kořen s nižším indexem a
+     * cesty se zkracují půlením. Komponenty jsou číslovány v pořadí svého prvního uzlu.
+     *
+     * @param[in] threadCount počet vláken
+     * @return číslo komponenty pro každý index uzlu (viz indexOf) a velikosti komponent
+     */
+    ComponentLabels connectedComponents(size_t threadCount = 1) const;
+
+    /**
+     * Přeskládá uzly v paměti tak, aby sousední uzly měly blízké indexy (viz indexOf). Id uzlů, hrany ani
+     * barvy se nemění, mění se jen indexy a pořadí v nodes() a nodesView(). Seznamy sousedů jsou po
+     * přečíslování seřazené vzestupně podle indexu.
+     *
+     * @param[in] strategy způsob přečíslování
+     * @return průměrná mezera mezi indexy sousedů před a po přečíslování
+     */
+    ReorderStats reorder(ReorderStrategy strategy);
+
+    /**
+     * @return průměr |index(a) - index(b)| přes všechny hrany, 0 pro graf bez hran
+     */
+    double averageGap() const;
+
+    /**
+     * Spočítá trojúhelníky v grafu. Hrany jsou orientovány od uzlu nižšího stupně k uzlu vyššího
+     * stupně, takže každý trojúhelník je nalezen jednou jako průnik dvou krátkých seřazených seznamů.
+     * Indexy uzlů jsou 32bitové, graf smí mít nejvýše 2^32 uzlů.
+     *
+     * @param[in] threadCount počet vláken
+     * @param[in] kernel implementace průniku seznamů
+     * @return počet trojúhelníků
+     * @exception length_error pokud má graf více než 2^32 uzlů
+     */
+    size_t triangleCount(size_t threadCount = 1, IntersectKernel kernel = IntersectKernel::Best) const;
+
+    /**
+     * @param[in] threadCount počet vláken
+     * @param[in] kernel implementace průniku seznamů
+     * @return počet trojúhelníků obsahujících uzel pro každý index uzlu (viz indexOf)
+     * @exception length_error pokud má graf více než 2^32 uzlů
+     */
+    std::vector<size_t> nodeTriangles(size_t threadCount = 1, IntersectKernel kernel = IntersectKernel::Best) const;
+
+    /**
+     * Lokální shlukovací koeficient je podíl existujících hran mezi sousedy uzlu ku všem možným,
+     * tedy 2 * trojúhelníky / (stupeň * (stupeň - 1)). Uzly se stupněm nižším než 2 mají koeficient 0.
+     *
+     * @param[in] threadCount počet vláken
+     * @return shlukovací koeficient pro každý index uzlu (viz indexOf)
+     * @exception length_error pokud má graf více než 2^32 uzlů
+     */
+    std::vector<double> clusteringCoefficients(size_t threadCount = 1) const;
+
     /**
      * Smazání všech uzlů a hran v grafu.
      */
     void clear();
 
 protected:
-    // doplňte vhodné struktury
+    /**
+     * @brief Normalizovaný klíč hrany, vždy platí lo < hi.
+     */
+    struct EdgeKey{
+        size_t lo;  ///< menší z id koncových uzlů
+        size_t hi;  ///< větší z id koncových uzlů
+
+        bool operator==(const EdgeKey& other) const{
+            return lo == other.lo && hi == other.hi;
+        }
+
+        bool operator<(const EdgeKey& other) const{
+            return lo != other.lo ? lo < other.lo : hi < other.hi;
+        }
+    };
+
+    /**
+     * @brief Hašovací funkce pro klíč hrany.
+     */
+    struct EdgeKeyHash{
+        size_t operator()(const EdgeKey& key) const;
+    };
+
+    /**
+     * @brief Vytvoří normalizovaný klíč hrany (min, max).
+     * @param[in] a id uzlu a
+     * @param[in] b id uzlu b
+     * @return klíč hrany
+     */
+    static EdgeKey makeEdgeKey(size_t a, size_t b){
+        return a < b ? EdgeKey{a, b} : EdgeKey{b, a};
+    }
+
+    /**
+     * @brief Vyhledá pozici uzlu ve vektoru graphNodes.
+     * @param[in] nodeId id uzlu
+     * @return pozice uzlu nebo NodeIndex::npos, pokud uzel neexistuje
+     */
+    size_t slotOf(size_t nodeId) const{
+        return nodeIndex.find(nodeId);
+    }
+
+    /**
+     * @brief Přiřadí uzlu nejnižší barvu, kterou nemá žádný jeho soused.
+     * @param[in] slot pozice uzlu v graphNodes
+     * @param[in, out] mask maska nastavená alespoň na graphDegree() + 1 barev, po návratu opět prázdná
+     * @param[in, out] colors barvy uzlů indexované pozicí, neobarvené uzly mají barvu -1
+     * @return přiřazená barva
+     */
+    size_t assignFirstFreeColor(size_t slot, ColorMask& mask, std::vector<size_t>& colors);
+
+    /**
+     * @brief Zapíše barvy z pole indexovaného pozicí do uzlů.
+     * @param[in] colors barva pro každou pozici v graphNodes
+     */
+    void storeColors(const std::vector<size_t>& colors);
+
+    /**
+     * @brief Obarví všechny uzly hladově v zadaném pořadí.
+     * @param[in] order pozice všech uzlů v graphNodes v pořadí barvení
+     * @return počet použitých barev
+     */
+    size_t colorInOrder(const std::vector<size_t>& order);
+
+    /**
+     * @return pozice uzlů seřazené sestupně podle stupně
+     */
+    std::vector<size_t> largestFirstOrder() const;
+
+    /**
+     * @return pozice uzlů v degeneračním pořadí (smallest-last)
+     */
+    std::vector<size_t> smallestLastOrder() const;
+
+    /**
+     * @return pozice uzlů v obráceném pořadí Cuthill–McKee
+     */
+    std::vector<size_t> reverseCuthillMcKeeOrder() const;
+
+    /**
+     * @return pozice uzlů s nadprůměrným stupněm a za nimi ostatní, obojí v původním pořadí
+     */
+    std::vector<size_t> hubClusteringOrder() const;
+
+    /**
+     * @brief Přesune uzly na nové pozice a přepíše podle nich seznamy sousedů a index id.
+     * @param[in] order původní pozice uzlů v novém pořadí
+     */
+    void permuteNodes(const std::vector<size_t>& order);
+
+    /**
+     * @brief Obarví graf algoritmem DSatur.
+     * @return počet použitých barev
+     */
+    size_t colorDSatur();
+
+    /**
+     * @brief Přepočítá histogram barev podle uzlů a uloží výchozí počet barev pro průběžné barvení.
+     */
+    void trackColors();
+
+    /**
+     * @brief Změní barvu uzlu a upraví histogram barev.
+     * @param[in] slot pozice uzlu v graphNodes
+     * @param[in] color nová barva
+     */
+    void setTrackedColor(size_t slot, size_t color);
+
+    /**
+     * @brief Odstraní konflikt barev na nové hraně a případně spustí úplné přebarvení.
+     * @param[in] edge nově přidaná hrana
+     */
+    void repairColoring(const Edge& edge);
+
+    /**
+     * @brief Seřadí klíče hran lexikograficky LSD radix sortem po 16 bitech.
+     * Průchody, ve kterých mají všechny klíče stejnou číslici, jsou přeskočeny.
+     * @param[in, out] first začátek řazeného rozsahu
+     * @param[in, out] last konec řazeného rozsahu
+     * @param[in] buffer pomocná paměť o velikosti řazeného rozsahu
+     */
+    static void radixSort(EdgeKey* first, EdgeKey* last, EdgeKey* buffer);
+
+    /**
+     * @brief Seřadí klíče hran, pro více vláken řadí části paralelně a slévá je po dvojicích.
+     * @param[in, out] keys klíče hran
+     * @param[in] threadCount počet vláken
+     */
+    static void sortEdgeKeys(std::vector<EdgeKey>& keys, size_t threadCount);
+
+    /**
+     * @brief Hromadně přidá hrany zadané normalizovanými klíči bez smyček.
+     * @param[in, out] keys klíče hran, funkce je seřadí a odstraní z nich duplicity
+     * @param[in] threadCount počet vláken pro řazení
+     */
+    void addEdgeKeys(std::vector<EdgeKey>& keys, size_t threadCount);
+
+    /**
+     * @brief Odstraní sousední uzel ze seznamu sousedů.
+     * @param[in, out] neighbors seznam sousedů
+     * @param[in] neighbor pozice odstraňovaného souseda v graphNodes
+     */
+    static void eraseNeighbor(std::vector<size_t>& neighbors, size_t neighbor);
+
+    /**
+     * @brief Přesune jeden uzel mezi přihrádkami histogramu stupňů a udržuje maximální stupeň.
+     * @param[in] from původní stupeň uzlu
+     * @param[in] to nový stupeň uzlu
+     */
+    void moveDegree(size_t from, size_t to);
+
+    /**
+     * @brief Odstraní hranu z vektoru hran na dané pozici a opraví index přesunuté hrany.
+     * @param[in] position pozice hrany ve vektoru graphEdges
+     */
+    void eraseEdgeAt(size_t position);
+
+    NodeArena nodeArena;                                            ///< paměť pro uzly v graphNodes
     std::vector<Node*> graphNodes; 
     std::vector<Edge> graphEdges;
 
+    NodeIndex nodeIndex;                                            ///< id uzlu -> pozice v graphNodes
+    std::vector<std::vector<size_t>> adjacency;                     ///< pozice sousedních uzlů, indexováno pozicí uzlu
+    std::unordered_map<EdgeKey, size_t, EdgeKeyHash> edgeIndex;     ///< klíč hrany -> pozice v graphEdges
+
+    std::vector<size_t> degreeHistogram;                            ///< počet uzlů pro každý stupeň
+    size_t maxDegree = 0;                                           ///< nejvyšší stupeň s neprázdnou přihrádkou
+
+    bool incrementalColoring = false;                               ///< udržuje se obarvení při změnách
+    size_t colorDriftLimit = 0;                                     ///< povolený nárůst počtu barev
+    ColoringStrategy recolorStrategy = ColoringStrategy::SmallestLast; ///< strategie úplného přebarvení
+    size_t baselineColors = 0;                                      ///< počet barev po posledním úplném obarvení
+    std::vector<size_t> colorHistogram;                             ///< počet uzlů pro každou barvu
+    size_t colorsInUse = 0;                                         ///< nejvyšší barva s nenulovým počtem uzlů
+    ColorMask recolorMask;                                          ///< maska pro přebarvení jednoho uzlu
+
 };
 
 #endif // TDD_CODE_H_
@@ -0,0 +1,134 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_compressed_graph.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_compressed_graph.cpp
+ * @author David Bujzaš
+ *
+ * @brief Komprese seznamů sousedů a dotazy nad nimi.
+ */
+
+#include "tdd_compressed_graph.h"
+
+namespace {
+
+void encodeVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+} // namespace
+
+CompressedGraph::CompressedGraph(const CsrGraph& graph) {
+    compress(graph);
+}
+
+CompressedGraph::CompressedGraph(const Graph& graph) {
+    compress(graph.freeze());
+}
+
+// neighbor lists of a CsrGraph are already sorted, so every gap after the first index is positive
+void CompressedGraph::compress(const CsrGraph& graph) {
+    size_t count = graph.nodeCount();
+    ids.resize(count);
+    offsets.resize(count + 1);
+    data.clear();
+    data.reserve(count + 2 * graph.edgeCount());
+
+    for (size_t index = 0; index < count; index++) {
+        ids[index] = graph.nodeIdAt(index);
+        offsets[index] = data.size();
+
+        Span<uint64_t> neighbors = graph.neighborsAt(index);
+        encodeVarint(data, neighbors.size());
+        uint64_t previous = 0;
+        for (auto neighbor : neighbors) {
+            encodeVarint(data, neighbor - previous);
+            previous = neighbor;
+        }
+    }
+    offsets[count] = data.size();
+    data.shrink_to_fit();
+
+    edges = graph.edgeCount();
+    maxDegree = graph.graphDegree();
+}
+
+size_t CompressedGraph::indexOf(size_t nodeId) const {
+    auto i = std::lower_bound(ids.begin(), ids.end(), static_cast<uint64_t>(nodeId));
+    return i != ids.end() && *i == nodeId ? static_cast<size_t>(i - ids.begin()) : NodeIndex::npos;
+}
+
+bool CompressedGraph::containsEdge(const Edge& edge) const {
+    size_t a = indexOf(edge.a);
+    size_t b = indexOf(edge.b);
+    if (a == NodeIndex::npos || b == NodeIndex::npos) {
+        return false;
+    }
+
+    // the shorter list is decoded until it reaches the index of the other node
+    const uint8_t* positionA = data.data() + offsets[a];
+    const uint8_t* positionB = data.data() + offsets[b];
+    uint64_t degreeA = decodeVarint(positionA);
+    uint64_t degreeB = decodeVarint(positionB);
+    const uint8_t* position = positionA;
+    uint64_t degree = degreeA;
+    uint64_t target = b;
+    if (degreeB < degreeA) {
+        position = positionB;
+        degree = degreeB;
+        target = a;
+    }
+
+    uint64_t neighbor = 0;
+    for (uint64_t i = 0; i < degree; i++) {
+        neighbor += decodeVarint(position);
+        if (neighbor >= target) {
+            return neighbor == target;
+        }
+    }
+    return false;
+}
+
+size_t CompressedGraph::nodeDegree(size_t nodeId) const {
+    size_t index = indexOf(nodeId);
+    if (index == NodeIndex::npos) {
+        throw std::out_of_range("Node does not exist!\n");
+    }
+    return degreeAt(index);
+}
+
+// every list is decoded once straight into the mask, then the mask is cleared up to the highest
+// forbidden color instead of decoding the list again to allow the colors one by one
+size_t CompressedGraph::coloring(size_t* colors) const {
+    std::fill(colors, colors + ids.size(), 0);
+
+    ColorMask mask;
+    mask.reset(maxDegree + 1);
+    size_t colorCount = 0;
+    for (size_t index = 0; index < ids.size(); index++) {
+        size_t highest = 0;
+        forEachNeighbor(index, [&](size_t neighbor) {
+            mask.forbid(colors[neighbor]);
+            highest = std::max(highest, colors[neighbor]);
+        });
+        colors[index] = mask.firstFree();
+        colorCount = std::max(colorCount, colors[index]);
+        mask.allowAll(highest);
+    }
+    return colorCount;
+}
+
+size_t CompressedGraph::memoryBytes() const {
+    return ids.size() * sizeof(uint64_t) + offsets.size() * sizeof(uint64_t) + data.size();
+}
+
+/*** Konec souboru tdd_compressed_graph.cpp ***/
@@ -0,0 +1,158 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_compressed_graph.h
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_compressed_graph.h
+ * @author David Bujzaš
+ *
+ * @brief Neměnný graf s komprimovanými seznamy sousedů.
+ */
+#pragma once
+
+#ifndef TDD_COMPRESSED_GRAPH_H_
+#define TDD_COMPRESSED_GRAPH_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "tdd_csr_graph.h"
+
+/**
+ * @brief Neměnný graf, jehož seznamy sousedů jsou uloženy jako rozdíly ve formátu varint.
+ *
+ * Uzly mají husté indexy v pořadí vzestupných id stejně jako CsrGraph. Seznam uzlu začíná stupněm,
+ * následuje index prvního souseda a rozdíly mezi po sobě jdoucími seřazenými indexy, vše jako varint
+ * (7 bitů na bajt, nejvyšší bit značí pokračování). Malé rozdíly po přečíslování (Graph::reorder)
+ * zabírají jeden bajt. Dotazy jsou konstantní a lze je volat z více vláken.
+ */
+class CompressedGraph{
+public:
+    /**
+     * @brief Zkomprimuje graf ve formátu CSR, například FrozenGraph nebo MappedGraph.
+     * @param[in] graph graf
+     */
+    explicit CompressedGraph(const CsrGraph& graph);
+
+    /**
+     * @brief Zkomprimuje graf přes dočasný snímek FrozenGraph.
+     * @param[in] graph graf
+     */
+    explicit CompressedGraph(const Graph& graph);
+
+    /**
+     * @return počet uzlů v grafu
+     */
+    size_t nodeCount() const { return ids.size(); }
+
+    /**
+     * @return počet hran v grafu
+     */
+    size_t edgeCount() const { return edges; }
+
+    /**
+     * @return maximální stupeň uzlu v grafu
+     */
+    size_t graphDegree() const { return maxDegree; }
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return hustý index uzlu nebo NodeIndex::npos, pokud uzel neexistuje
+     */
+    size_t indexOf(size_t nodeId) const;
+
+    /**
+     * @param[in] index hustý index uzlu
+     * @return id uzlu
+     */
+    size_t nodeIdAt(size_t index) const { return ids[index]; }
+
+    /**
+     * @brief Zjistí, zda hrana existuje. Dekóduje kratší ze dvou seznamů jen po hledaný index.
+     * @param[in] edge hrana, která nás zajímá
+     * @return true pokud hrana existuje, jinak false
+     */
+    bool containsEdge(const Edge& edge) const;
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return stupeň uzlu
+     * @exception out_of_range pokud uzel v grafu neexistuje
+     */
+    size_t nodeDegree(size_t nodeId) const;
+
+    /**
+     * @param[in] index hustý index uzlu
+     * @return stupeň uzlu, přečte jen první varint seznamu
+     */
+    size_t degreeAt(size_t index) const{
+        const uint8_t* position = data.data() + offsets[index];
+        return decodeVarint(position);
+    }
+
+    /**
+     * @brief Zavolá funkci pro husté indexy všech sousedů uzlu ve vzestupném pořadí.
+     * @param[in] index hustý index uzlu
+     * @param[in] function funkce volaná jako function(index souseda)
+     */
+    template<typename Function>
+    void forEachNeighbor(size_t index, Function function) const{
+        const uint8_t* position = data.data() + offsets[index];
+        uint64_t degree = decodeVarint(position);
+        uint64_t neighbor = 0;
+        for (uint64_t i = 0; i < degree; i++) {
+            neighbor += decodeVarint(position);
+            function(static_cast<size_t>(neighbor));
+        }
+    }
+
+    /**
+     * Hladově obarví uzly v pořadí hustých indexů, výsledek je stejný jako u CsrGraph::coloring.
+     *
+     * @param[out] colors barva od 1 pro každý hustý index uzlu, pole musí mít alespoň nodeCount() prvků
+     * @return počet použitých barev
+     */
+    size_t coloring(size_t* colors) const;
+
+    /**
+     * @return počet bajtů obsazených poli grafu
+     */
+    size_t memoryBytes() const;
+
+    /**
+     * @brief Přečte jedno číslo ve formátu varint a posune ukazatel za něj.
+     * @param[in, out] position ukazatel na první bajt čísla
+     * @return přečtené číslo
+     */
+    static uint64_t decodeVarint(const uint8_t*& position){
+        uint64_t value = *position++;
+        if (value < 0x80) {
+            return value;
+        }
+        value &= 0x7F;
+        for (unsigned shift = 7;; shift += 7) {
+            uint64_t byte = *position++;
+            value |= (byte & 0x7F) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+    }
+
+private:
+    void compress(const CsrGraph& graph);
+
+    std::vector<uint64_t> ids;      ///< id uzlů seřazená vzestupně
+    std::vector<uint64_t> offsets;  ///< začátek seznamu každého uzlu v data, nodeCount + 1 prvků
+    std::vector<uint8_t> data;      ///< zakódované seznamy sousedů
+    size_t edges = 0;
+    size_t maxDegree = 0;
+};
+
+#endif // TDD_COMPRESSED_GRAPH_H_
+
+/*** Konec souboru tdd_compressed_graph.h ***/
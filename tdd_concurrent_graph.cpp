@@ -0,0 +1,177 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_concurrent_graph.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_concurrent_graph.cpp
+ * @author David Bujzaš
+ *
+ * @brief Implementace grafu se shardovanými zámky.
+ */
+
+#include "tdd_concurrent_graph.h"
+
+#include <mutex>
+
+namespace {
+
+using SharedLock = std::shared_lock<std::shared_mutex>;
+using UniqueLock = std::unique_lock<std::shared_mutex>;
+
+} // namespace
+
+ConcurrentGraph::ConcurrentGraph(size_t shardCount) {
+    size_t count = 1;
+    while (count < shardCount) {
+        count <<= 1;
+    }
+    shards.reset(new Shard[count]);
+    shardMask = count - 1;
+}
+
+// mixes the id so that sequential ids spread over all shards
+size_t ConcurrentGraph::shardIndex(size_t nodeId) const {
+    uint64_t x = nodeId;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<size_t>(x ^ (x >> 31)) & shardMask;
+}
+
+bool ConcurrentGraph::addNode(size_t nodeId) {
+    Shard& shard = shards[shardIndex(nodeId)];
+    UniqueLock lock(shard.mutex);
+    if (!shard.adjacency.try_emplace(nodeId).second) {
+        return false;
+    }
+    nodes.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ConcurrentGraph::addEdge(const Edge& edge) {
+    if (edge.a == edge.b) {
+        return false;
+    }
+
+    // locks both shards in ascending order so two writers never wait on each other crosswise
+    size_t first = shardIndex(edge.a);
+    size_t second = shardIndex(edge.b);
+    Shard& shardA = shards[first];
+    Shard& shardB = shards[second];
+    if (first > second) {
+        std::swap(first, second);
+    }
+    UniqueLock lockFirst(shards[first].mutex);
+    UniqueLock lockSecond;
+    if (second != first) {
+        lockSecond = UniqueLock(shards[second].mutex);
+    }
+
+    auto a = shardA.adjacency.try_emplace(edge.a);
+    auto b = shardB.adjacency.try_emplace(edge.b);
+    nodes.fetch_add(a.second + b.second, std::memory_order_relaxed);
+    if (!a.first->second.insert(edge.b).second) {
+        return false;
+    }
+    b.first->second.insert(edge.a);
+    edgeTotal.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ConcurrentGraph::removeEdge(const Edge& edge) {
+    size_t first = shardIndex(edge.a);
+    size_t second = shardIndex(edge.b);
+    Shard& shardA = shards[first];
+    Shard& shardB = shards[second];
+    if (first > second) {
+        std::swap(first, second);
+    }
+    UniqueLock lockFirst(shards[first].mutex);
+    UniqueLock lockSecond;
+    if (second != first) {
+        lockSecond = UniqueLock(shards[second].mutex);
+    }
+
+    auto a = shardA.adjacency.find(edge.a);
+    if (a == shardA.adjacency.end() || a->second.erase(edge.b) == 0) {
+        throw std::out_of_range("Edge does not exist!\n");
+    }
+    shardB.adjacency[edge.b].erase(edge.a);
+    edgeTotal.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ConcurrentGraph::removeNode(size_t nodeId) {
+    // the neighbors may live in any shard, so all of them are locked in ascending order
+    std::vector<UniqueLock> locks;
+    locks.reserve(shardCount());
+    for (size_t i = 0; i < shardCount(); i++) {
+        locks.emplace_back(shards[i].mutex);
+    }
+
+    Shard& shard = shards[shardIndex(nodeId)];
+    auto node = shard.adjacency.find(nodeId);
+    if (node == shard.adjacency.end()) {
+        throw std::out_of_range("Node does not exist!\n");
+    }
+    for (auto neighborId : node->second) {
+        shards[shardIndex(neighborId)].adjacency[neighborId].erase(nodeId);
+    }
+    edgeTotal.fetch_sub(node->second.size(), std::memory_order_relaxed);
+    shard.adjacency.erase(node);
+    nodes.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool ConcurrentGraph::containsNode(size_t nodeId) const {
+    const Shard& shard = shards[shardIndex(nodeId)];
+    SharedLock lock(shard.mutex);
+    return shard.adjacency.find(nodeId) != shard.adjacency.end();
+}
+
+// both directions are stored, so only the shard of one end is read
+bool ConcurrentGraph::containsEdge(const Edge& edge) const {
+    const Shard& shard = shards[shardIndex(edge.a)];
+    SharedLock lock(shard.mutex);
+    auto node = shard.adjacency.find(edge.a);
+    return node != shard.adjacency.end() && node->second.count(edge.b) != 0;
+}
+
+size_t ConcurrentGraph::nodeDegree(size_t nodeId) const {
+    const Shard& shard = shards[shardIndex(nodeId)];
+    SharedLock lock(shard.mutex);
+    auto node = shard.adjacency.find(nodeId);
+    if (node == shard.adjacency.end()) {
+        throw std::out_of_range("Node does not exist!\n");
+    }
+    return node->second.size();
+}
+
+std::vector<size_t> ConcurrentGraph::neighbors(size_t nodeId) const {
+    const Shard& shard = shards[shardIndex(nodeId)];
+    SharedLock lock(shard.mutex);
+    auto node = shard.adjacency.find(nodeId);
+    if (node == shard.adjacency.end()) {
+        throw std::out_of_range("Node does not exist!\n");
+    }
+    return std::vector<size_t>(node->second.begin(), node->second.end());
+}
+
+std::vector<Edge> ConcurrentGraph::edges() const {
+    std::vector<Edge> result;
+    result.reserve(edgeCount());
+    for (size_t i = 0; i < shardCount(); i++) {
+        SharedLock lock(shards[i].mutex);
+        for (const auto& node : shards[i].adjacency) {
+            for (auto neighborId : node.second) {
+                if (node.first < neighborId) {
+                    result.emplace_back(node.first, neighborId);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/*** Konec souboru tdd_concurrent_graph.cpp ***/
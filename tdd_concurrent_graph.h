@@ -0,0 +1,143 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_concurrent_graph.h
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_concurrent_graph.h
+ * @author David Bujzaš
+ *
+ * @brief Graf, který lze současně měnit a číst z více vláken.
+ */
+#pragma once
+
+#ifndef TDD_CONCURRENT_GRAPH_H_
+#define TDD_CONCURRENT_GRAPH_H_
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "tdd_code.h"
+
+/**
+ * @brief Neorientovaný graf bez smyček bezpečný pro souběžný přístup.
+ *
+ * Uzly jsou podle haše id rozděleny do shardů. Každý shard má vlastní zámek a sousedy svých uzlů,
+ * hrana je uložena v seznamech sousedů obou koncových uzlů. Čtení zamyká jediný shard pro sdílený
+ * přístup, takže se čtenáři navzájem neblokují a se zapisovateli soupeří jen v rámci shardu.
+ * Přidání a odebrání hrany zamyká nejvýše dva shardy ve vzestupném pořadí.
+ */
+class ConcurrentGraph{
+public:
+    /**
+     * @param[in] shardCount požadovaný počet shardů, zaokrouhlí se nahoru na mocninu dvojky
+     */
+    explicit ConcurrentGraph(size_t shardCount = 64);
+
+    ConcurrentGraph(const ConcurrentGraph&) = delete;
+    ConcurrentGraph& operator=(const ConcurrentGraph&) = delete;
+
+    /**
+     * @param[in] nodeId id nového uzlu
+     * @return true pokud byl uzel přidán, false pokud už existoval
+     */
+    bool addNode(size_t nodeId);
+
+    /**
+     * Přidá hranu a chybějící koncové uzly.
+     *
+     * @param[in] edge nová hrana
+     * @return true pokud byla hrana přidána, false pokud už existovala nebo je smyčkou
+     */
+    bool addEdge(const Edge& edge);
+
+    /**
+     * @param[in] edge hrana, která má být odstraněna
+     * @exception out_of_range pokud hrana v grafu neexistuje
+     */
+    void removeEdge(const Edge& edge);
+
+    /**
+     * Odstraní uzel a všechny jeho hrany. Zamyká všechny shardy, proto je určeno pro vzácné operace.
+     *
+     * @param[in] nodeId id uzlu
+     * @exception out_of_range pokud uzel v grafu neexistuje
+     */
+    void removeNode(size_t nodeId);
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return true pokud uzel existuje
+     */
+    bool containsNode(size_t nodeId) const;
+
+    /**
+     * @param[in] edge hrana, která nás zajímá
+     * @return true pokud hrana existuje
+     */
+    bool containsEdge(const Edge& edge) const;
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return stupeň uzlu
+     * @exception out_of_range pokud uzel v grafu neexistuje
+     */
+    size_t nodeDegree(size_t nodeId) const;
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return kopie id sousedů v libovolném pořadí
+     * @exception out_of_range pokud uzel v grafu neexistuje
+     */
+    std::vector<size_t> neighbors(size_t nodeId) const;
+
+    /**
+     * Shardy se procházejí postupně, při souběžných změnách proto výsledek nemusí odpovídat
+     * jedinému okamžiku.
+     *
+     * @return kopie všech hran, každá je uvedena jednou
+     */
+    std::vector<Edge> edges() const;
+
+    /**
+     * @return počet uzlů v grafu
+     */
+    size_t nodeCount() const { return nodes.load(std::memory_order_relaxed); }
+
+    /**
+     * @return počet hran v grafu
+     */
+    size_t edgeCount() const { return edgeTotal.load(std::memory_order_relaxed); }
+
+    /**
+     * @return počet shardů
+     */
+    size_t shardCount() const { return shardMask + 1; }
+
+private:
+    /**
+     * @brief Část grafu chráněná jedním zámkem, zarovnaná na cache line kvůli false sharingu.
+     */
+    struct alignas(64) Shard{
+        mutable std::shared_mutex mutex;
+        std::unordered_map<size_t, std::unordered_set<size_t>> adjacency;  ///< sousedé uzlů shardu
+    };
+
+    size_t shardIndex(size_t nodeId) const;
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shardMask = 0;
+    std::atomic<size_t> nodes{0};
+    std::atomic<size_t> edgeTotal{0};
+};
+
+#endif // TDD_CONCURRENT_GRAPH_H_
+
+/*** Konec souboru tdd_concurrent_graph.h ***/
@@ -0,0 +1,155 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_csr_graph.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_csr_graph.cpp
+ * @author David Bujzaš
+ *
+ * @brief Implementace dotazů nad grafem ve formátu CSR a vytvoření neměnného snímku grafu.
+ */
+
+#include "tdd_csr_graph.h"
+#include "tdd_subgraph.h"
+
+void CsrGraph::assign(const uint64_t* ids, const uint64_t* offsets, const uint64_t* neighbors, size_t nodeCount,
+                      size_t maxDegree) {
+    this->ids = ids;
+    this->offsets = offsets;
+    this->neighborIndices = neighbors;
+    this->nodes = nodeCount;
+    this->maxDegree = maxDegree;
+}
+
+size_t CsrGraph::indexOf(size_t nodeId) const {
+    const uint64_t* end = ids + nodes;
+    const uint64_t* i = std::lower_bound(ids, end, static_cast<uint64_t>(nodeId));
+    return i != end && *i == nodeId ? static_cast<size_t>(i - ids) : NodeIndex::npos;
+}
+
+size_t CsrGraph::checkedIndex(size_t nodeId) const {
+    size_t index = indexOf(nodeId);
+    if (index == NodeIndex::npos) {
+        throw std::out_of_range("Node does not exist!\n");
+    }
+    return index;
+}
+
+bool CsrGraph::containsEdge(const Edge& edge) const {
+    size_t a = indexOf(edge.a);
+    size_t b = indexOf(edge.b);
+    if (a == NodeIndex::npos || b == NodeIndex::npos) {
+        return false;
+    }
+
+    // searches the shorter list
+    if (offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b]) {
+        std::swap(a, b);
+    }
+    return std::binary_search(neighborIndices + offsets[a], neighborIndices + offsets[a + 1],
+                              static_cast<uint64_t>(b));
+}
+
+size_t CsrGraph::nodeDegree(size_t nodeId) const {
+    size_t index = checkedIndex(nodeId);
+    return offsets[index + 1] - offsets[index];
+}
+
+Span<uint64_t> CsrGraph::neighbors(size_t nodeId) const {
+    return neighborsAt(checkedIndex(nodeId));
+}
+
+size_t CsrGraph::coloring(size_t* colors) const {
+    // color 0 means uncolored, so neighbors later in the order never forbid anything
+    std::fill(colors, colors + nodes, 0);
+
+    ColorMask mask;
+    mask.reset(maxDegree + 1);
+    size_t colorCount = 0;
+    for (size_t index = 0; index < nodes; index++) {
+        Span<uint64_t> adjacent = neighborsAt(index);
+        for (auto neighbor : adjacent) {
+            mask.forbid(colors[neighbor]);
+        }
+        colors[index] = mask.firstFree();
+        colorCount = std::max(colorCount, colors[index]);
+        for (auto neighbor : adjacent) {
+            mask.allow(colors[neighbor]);
+        }
+    }
+    return colorCount;
+}
+
+// dense indices are the ranks of the node ids, neighbor lists are sorted by them
+FrozenGraph::FrozenGraph(const Graph& graph) {
+    size_t count = graph.nodeCount();
+
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&graph](size_t a, size_t b) {
+        return graph.nodeIdAt(a) < graph.nodeIdAt(b);
+    });
+
+    // rank translates the graph's own node index to the index in the snapshot
+    std::vector<size_t> rank(count);
+    idStorage.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        rank[order[i]] = i;
+        idStorage[i] = graph.nodeIdAt(order[i]);
+    }
+
+    offsetStorage.assign(count + 1, 0);
+    neighborStorage.reserve(2 * graph.edgeCount());
+    for (size_t i = 0; i < count; i++) {
+        for (auto neighbor : graph.neighborsAt(order[i])) {
+            neighborStorage.push_back(rank[neighbor]);
+        }
+        std::sort(neighborStorage.begin() + offsetStorage[i], neighborStorage.end());
+        offsetStorage[i + 1] = neighborStorage.size();
+    }
+
+    assign(idStorage.data(), offsetStorage.data(), neighborStorage.data(), count, graph.graphDegree());
+}
+
+// same layout as the snapshot of a whole graph, the degrees in the view give exact offsets up front
+FrozenGraph::FrozenGraph(const SubgraphView& view) {
+    size_t count = view.nodeCount();
+
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&view](size_t a, size_t b) {
+        return view.nodeIdAt(a) < view.nodeIdAt(b);
+    });
+
+    std::vector<size_t> rank(count);
+    idStorage.resize(count);
+    offsetStorage.assign(count + 1, 0);
+    for (size_t i = 0; i < count; i++) {
+        rank[order[i]] = i;
+        idStorage[i] = view.nodeIdAt(order[i]);
+        offsetStorage[i + 1] = offsetStorage[i] + view.degreeAt(order[i]);
+    }
+
+    neighborStorage.resize(offsetStorage[count]);
+    for (size_t i = 0; i < count; i++) {
+        uint64_t* position = neighborStorage.data() + offsetStorage[i];
+        view.forEachNeighbor(order[i], [&](size_t neighbor) { *position++ = rank[neighbor]; });
+        std::sort(neighborStorage.begin() + offsetStorage[i], neighborStorage.begin() + offsetStorage[i + 1]);
+    }
+
+    assign(idStorage.data(), offsetStorage.data(), neighborStorage.data(), count, view.graphDegree());
+}
+
+FrozenGraph Graph::freeze() const {
+    return FrozenGraph(*this);
+}
+
+/*** Konec souboru tdd_csr_graph.cpp ***/
@@ -0,0 +1,175 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_csr_graph.h
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_csr_graph.h
+ * @author David Bujzaš
+ *
+ * @brief Neměnné reprezentace grafu v kompaktním formátu CSR.
+ */
+#pragma once
+
+#ifndef TDD_CSR_GRAPH_H_
+#define TDD_CSR_GRAPH_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "tdd_code.h"
+
+class SubgraphView;
+
+/**
+ * @brief Dotazy nad grafem uloženým v polích CSR.
+ *
+ * Uzly mají husté indexy 0 až nodeCount() - 1 v pořadí vzestupných id. Seznam sousedů uzlu i leží
+ * v poli neighbors mezi offsets[i] a offsets[i + 1] a je seřazený vzestupně. Třída pole nevlastní,
+ * o jejich paměť se starají potomci. Všechny dotazy jsou konstantní, takže je lze bez zámků volat
+ * z více vláken.
+ */
+class CsrGraph{
+public:
+    /**
+     * @return počet uzlů v grafu
+     */
+    size_t nodeCount() const { return nodes; }
+
+    /**
+     * @return počet hran v grafu
+     */
+    size_t edgeCount() const { return offsets[nodes] / 2; }
+
+    /**
+     * @return maximální stupeň uzlu v grafu
+     */
+    size_t graphDegree() const { return maxDegree; }
+
+    /**
+     * @brief Vyhledá hustý index uzlu binárním vyhledáváním v seřazených id.
+     * @param[in] nodeId id uzlu
+     * @return hustý index uzlu nebo NodeIndex::npos, pokud uzel neexistuje
+     */
+    size_t indexOf(size_t nodeId) const;
+
+    /**
+     * @param[in] index hustý index uzlu
+     * @return id uzlu
+     */
+    size_t nodeIdAt(size_t index) const { return ids[index]; }
+
+    /**
+     * @brief Zjistí, zda hrana existuje. Hledá binárně v kratším ze dvou seznamů sousedů.
+     * @param[in] edge hrana, která nás zajímá
+     * @return true pokud hrana existuje, jinak false
+     */
+    bool containsEdge(const Edge& edge) const;
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return stupeň uzlu
+     * @exception out_of_range pokud uzel v grafu neexistuje
+     */
+    size_t nodeDegree(size_t nodeId) const;
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return pohled na husté indexy sousedů, id získáte metodou nodeIdAt
+     * @exception out_of_range pokud uzel v grafu neexistuje
+     */
+    Span<uint64_t> neighbors(size_t nodeId) const;
+
+    /**
+     * @param[in] index hustý index uzlu
+     * @return pohled na husté indexy sousedů
+     */
+    Span<uint64_t> neighborsAt(size_t index) const{
+        return Span<uint64_t>(neighborIndices + offsets[index], offsets[index + 1] - offsets[index]);
+    }
+
+    /**
+     * Hladově obarví uzly v pořadí hustých indexů. Graf se nemění, barvy jsou zapsány do pole volajícího.
+     * Nepoužije více než graphDegree + 1 barev.
+     *
+     * @param[out] colors barva od 1 pro každý hustý index uzlu, pole musí mít alespoň nodeCount() prvků
+     * @return počet použitých barev
+     */
+    size_t coloring(size_t* colors) const;
+
+protected:
+    CsrGraph() = default;
+    ~CsrGraph() = default;
+
+    /**
+     * @brief Nastaví pole, nad kterými se provádějí dotazy.
+     */
+    void assign(const uint64_t* ids, const uint64_t* offsets, const uint64_t* neighbors, size_t nodeCount,
+                size_t maxDegree);
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return hustý index uzlu
+     * @exception out_of_range pokud uzel v grafu neexistuje
+     */
+    size_t checkedIndex(size_t nodeId) const;
+
+    const uint64_t* ids = nullptr;              ///< id uzlů seřazená vzestupně
+    const uint64_t* offsets = nullptr;          ///< začátky seznamů sousedů, nodeCount + 1 prvků
+    const uint64_t* neighborIndices = nullptr;  ///< husté indexy sousedů
+    size_t nodes = 0;                           ///< počet uzlů
+    size_t maxDegree = 0;                       ///< maximální stupeň uzlu
+};
+
+/**
+ * @brief Neměnný snímek grafu v paměti ve formátu CSR.
+ *
+ * Snímek je nezávislý na původním grafu, který lze dál měnit. Dotazy nad snímkem lze bez zámků
+ * volat z libovolného počtu vláken.
+ */
+class FrozenGraph : public CsrGraph{
+public:
+    /**
+     * @brief Vytvoří snímek aktuálního stavu grafu.
+     * @param[in] graph graf
+     */
+    explicit FrozenGraph(const Graph& graph);
+
+    /**
+     * @brief Vytvoří snímek podgrafu, obsahuje jen uzly podgrafu a hrany mezi nimi.
+     * @param[in] view pohled na podgraf
+     */
+    explicit FrozenGraph(const SubgraphView& view);
+
+    FrozenGraph(FrozenGraph&& other) = default;
+    FrozenGraph& operator=(FrozenGraph&& other) = default;
+    FrozenGraph(const FrozenGraph&) = delete;
+    FrozenGraph& operator=(const FrozenGraph&) = delete;
+
+    /**
+     * @return id uzlů seřazená vzestupně
+     */
+    const std::vector<uint64_t>& idArray() const { return idStorage; }
+
+    /**
+     * @return začátky seznamů sousedů
+     */
+    const std::vector<uint64_t>& offsetArray() const { return offsetStorage; }
+
+    /**
+     * @return husté indexy sousedů
+     */
+    const std::vector<uint64_t>& neighborArray() const { return neighborStorage; }
+
+private:
+    std::vector<uint64_t> idStorage;
+    std::vector<uint64_t> offsetStorage;
+    std::vector<uint64_t> neighborStorage;
+};
+
+#endif // TDD_CSR_GRAPH_H_
+
+/*** Konec souboru tdd_csr_graph.h ***/
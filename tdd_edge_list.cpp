@@ -0,0 +1,178 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_edge_list.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_edge_list.cpp
+ * @author David Bujzaš
+ *
+ * @brief Import grafu z textového seznamu hran (SNAP, Matrix Market).
+ */
+
+#include "tdd_code.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// parses edge list lines in [begin, end), the range always ends right after a newline or at the end of file
+bool parseEdgeLines(const char* begin, const char* end, std::vector<std::pair<size_t, size_t>>& edges) {
+    const char* p = begin;
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            p++;
+        }
+        if (p == end) {
+            break;
+        }
+        if (*p == '\n' || *p == '#' || *p == '%') {
+            while (p < end && *p != '\n') {
+                p++;
+            }
+            p += p < end;
+            continue;
+        }
+
+        size_t ids[2];
+        for (size_t i = 0; i < 2; i++) {
+            while (p < end && (*p == ' ' || *p == '\t')) {
+                p++;
+            }
+            if (p == end || *p < '0' || *p > '9') {
+                return false;
+            }
+            size_t value = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                size_t digit = static_cast<size_t>(*p - '0');
+                // an id that does not fit into size_t would otherwise wrap into another valid id
+                if (value > (SIZE_MAX - digit) / 10) {
+                    return false;
+                }
+                value = value * 10 + digit;
+                p++;
+            }
+            // an id must end with a separator, so 4x, 4.5 or 2e3 are not read as a shorter id
+            if (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+                return false;
+            }
+            ids[i] = value;
+        }
+        if (ids[0] != ids[1]) {
+            edges.emplace_back(ids[0], ids[1]);
+        }
+
+        // ignores the rest of the line, e.g. weights
+        while (p < end && *p != '\n') {
+            p++;
+        }
+        p += p < end;
+    }
+    return true;
+}
+
+} // namespace
+
+// reads the file chunk by chunk, the incomplete last line of a chunk is carried over to the next one
+size_t Graph::importEdgeList(const std::string& path, size_t chunkSize, size_t threadCount) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Edge list cannot be opened!\n");
+    }
+
+    threadCount = std::max<size_t>(threadCount, 1);
+    chunkSize = std::max<size_t>(chunkSize, 64);
+    std::vector<char> buffer(chunkSize);
+    std::vector<std::vector<std::pair<size_t, size_t>>> parsed(threadCount);
+    std::vector<EdgeKey> keys;
+    std::vector<char> failed(threadCount);
+    size_t carried = 0;
+    size_t edgesBefore = graphEdges.size();
+    bool firstChunk = true;
+    bool skipSizeLine = false;
+
+    while (true) {
+        // a line longer than the chunk makes the buffer grow
+        if (carried == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        file.read(buffer.data() + carried, static_cast<std::streamsize>(buffer.size() - carried));
+        size_t size = carried + static_cast<size_t>(file.gcount());
+        bool last = !file;
+        if (size == 0) {
+            break;
+        }
+
+        size_t begin = 0;
+        size_t end = size;
+        if (!last) {
+            while (end > 0 && buffer[end - 1] != '\n') {
+                end--;
+            }
+            if (end == 0) {
+                carried = size;
+                continue;
+            }
+        }
+
+        // a Matrix Market file has one size line after the comments, which is not an edge
+        if (firstChunk) {
+            skipSizeLine = size >= 14 && std::memcmp(buffer.data(), "%%MatrixMarket", 14) == 0;
+            firstChunk = false;
+        }
+        while (skipSizeLine && begin < end) {
+            size_t first = begin;
+            while (first < end && (buffer[first] == ' ' || buffer[first] == '\t' || buffer[first] == '\r')) {
+                first++;
+            }
+            skipSizeLine = first == end || buffer[first] == '%' || buffer[first] == '\n';
+            while (begin < end && buffer[begin] != '\n') {
+                begin++;
+            }
+            begin += begin < end;
+        }
+
+        // splits the chunk at line boundaries, one part per thread
+        std::vector<size_t> bounds(threadCount + 1, end);
+        bounds[0] = begin;
+        for (size_t t = 1; t < threadCount; t++) {
+            size_t split = std::max(bounds[t - 1], begin + (end - begin) * t / threadCount);
+            while (split < end && split > begin && buffer[split - 1] != '\n') {
+                split++;
+            }
+            bounds[t] = split;
+        }
+        parallelFor(threadCount, threadCount, [&](size_t first, size_t last, size_t) {
+            for (size_t t = first; t < last; t++) {
+                parsed[t].clear();
+                failed[t] = !parseEdgeLines(buffer.data() + bounds[t], buffer.data() + bounds[t + 1], parsed[t]);
+            }
+        });
+        if (std::find(failed.begin(), failed.end(), 1) != failed.end()) {
+            throw std::runtime_error("Edge list contains an invalid line!\n");
+        }
+
+        keys.clear();
+        for (auto& part : parsed) {
+            for (auto& edge : part) {
+                keys.push_back(makeEdgeKey(edge.first, edge.second));
+            }
+        }
+        addEdgeKeys(keys, threadCount);
+
+        carried = size - end;
+        std::memmove(buffer.data(), buffer.data() + end, carried);
+        if (last) {
+            break;
+        }
+    }
+
+    return graphEdges.size() - edgesBefore;
+}
+
+/*** Konec souboru tdd_edge_list.cpp ***/
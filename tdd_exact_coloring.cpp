@@ -0,0 +1,314 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_exact_coloring.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_exact_coloring.cpp
+ * @author David Bujzaš
+ *
+ * @brief Optimální obarvení grafu metodou větví a mezí nad bitovou maticí sousednosti.
+ */
+
+#include "tdd_code.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// the deadline is checked once per this many assignments
+const size_t STEPS_PER_CLOCK_CHECK = 1024;
+
+/**
+ * @brief Stav sdílený všemi vlákny prohledávání.
+ */
+struct SharedSearch{
+    size_t nodeCount;
+    size_t words;                          ///< počet 64bitových slov v řádku matice
+    std::vector<uint64_t> adjacency;       ///< bitová matice sousednosti po řádcích
+    std::vector<size_t> degree;
+    std::vector<std::pair<size_t, size_t>> fixed;  ///< uzly kliky s předem danými barvami
+
+    size_t lowerBound;
+    std::atomic<size_t> bound;             ///< počet barev nejlepšího nalezeného obarvení
+    std::mutex bestMutex;
+    std::vector<size_t> best;              ///< nejlepší nalezené obarvení indexované pozicí uzlu
+
+    bool hasDeadline;
+    Clock::time_point deadline;
+    std::atomic<bool> stopped{false};
+    std::atomic<bool> timedOut{false};
+
+    const uint64_t* row(size_t node) const { return adjacency.data() + node * words; }
+};
+
+/**
+ * @brief Prohledávání DSatur jednoho vlákna s vlastním částečným obarvením.
+ */
+class Search{
+public:
+    typedef std::vector<std::pair<size_t, size_t>> Path;  ///< přiřazení (uzel, barva) od kořene
+
+    explicit Search(SharedSearch& shared)
+        : shared(shared), stride(shared.bound.load() + 1), colors(shared.nodeCount, 0),
+          neighborColors(shared.nodeCount * stride, 0), saturation(shared.nodeCount, 0) { }
+
+    // clears the partial coloring and applies the clique colors and the given path
+    void reset(const Path& path) {
+        while (!assigned.empty()) {
+            unassign(assigned.back());
+        }
+        used = 0;
+        for (auto& assignment : shared.fixed) {
+            assign(assignment.first, assignment.second);
+        }
+        for (auto& assignment : path) {
+            assign(assignment.first, assignment.second);
+        }
+    }
+
+    bool complete() const { return assigned.size() == shared.nodeCount; }
+
+    // uncolored node with the most distinct neighbor colors, ties go to the higher degree
+    size_t select() const {
+        size_t selected = NodeIndex::npos;
+        for (size_t node = 0; node < shared.nodeCount; node++) {
+            if (colors[node] != 0) {
+                continue;
+            }
+            if (selected == NodeIndex::npos || saturation[node] > saturation[selected]
+                || (saturation[node] == saturation[selected] && shared.degree[node] > shared.degree[selected])) {
+                selected = node;
+            }
+        }
+        return selected;
+    }
+
+    // colors that keep the search below the best known count, a new color only right after the used ones
+    size_t colorLimit() const {
+        return std::min(used + 1, shared.bound.load(std::memory_order_relaxed) - 1);
+    }
+
+    bool allowed(size_t node, size_t color) const {
+        return neighborColors[node * stride + color] == 0;
+    }
+
+    void search() {
+        if (shared.stopped.load(std::memory_order_relaxed)) {
+            return;
+        }
+        if (++steps % STEPS_PER_CLOCK_CHECK == 0 && shared.hasDeadline && Clock::now() > shared.deadline) {
+            shared.timedOut.store(true);
+            shared.stopped.store(true);
+            return;
+        }
+        if (complete()) {
+            record();
+            return;
+        }
+
+        size_t node = select();
+        for (size_t color = 1; color <= colorLimit(); color++) {
+            if (!allowed(node, color)) {
+                continue;
+            }
+            size_t previousUsed = used;
+            assign(node, color);
+            search();
+            unassign(node);
+            used = previousUsed;
+            if (shared.stopped.load(std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    void assign(size_t node, size_t color) {
+        colors[node] = color;
+        used = std::max(used, color);
+        assigned.push_back(node);
+        forEachNeighbor(node, [this, color](size_t neighbor) {
+            if (neighborColors[neighbor * stride + color]++ == 0) {
+                saturation[neighbor]++;
+            }
+        });
+    }
+
+private:
+    void unassign(size_t node) {
+        size_t color = colors[node];
+        forEachNeighbor(node, [this, color](size_t neighbor) {
+            if (--neighborColors[neighbor * stride + color] == 0) {
+                saturation[neighbor]--;
+            }
+        });
+        colors[node] = 0;
+        assigned.pop_back();
+    }
+
+    template<typename Function>
+    void forEachNeighbor(size_t node, Function function) const {
+        const uint64_t* row = shared.row(node);
+        for (size_t w = 0; w < shared.words; w++) {
+            for (uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+                function(w * 64 + countTrailingZeros(bits));
+            }
+        }
+    }
+
+    // a complete coloring with fewer colors than the best one replaces it
+    void record() {
+        std::lock_guard<std::mutex> lock(shared.bestMutex);
+        if (used < shared.bound.load()) {
+            shared.bound.store(used);
+            shared.best = colors;
+            if (used <= shared.lowerBound) {
+                shared.stopped.store(true);
+            }
+        }
+    }
+
+    SharedSearch& shared;
+    size_t stride;                        ///< počet sloupců tabulky neighborColors
+    std::vector<size_t> colors;           ///< barva uzlu, 0 znamená neobarveno
+    std::vector<uint32_t> neighborColors; ///< počet sousedů uzlu s danou barvou
+    std::vector<size_t> saturation;       ///< počet různých barev sousedů
+    std::vector<size_t> assigned;         ///< obarvené uzly v pořadí obarvení
+    size_t used = 0;                      ///< nejvyšší použitá barva
+    size_t steps = 0;
+};
+
+// grows a clique greedily from the highest degree nodes, always adding the candidate of highest degree
+std::vector<size_t> greedyClique(const SharedSearch& shared, const std::vector<size_t>& byDegree) {
+    std::vector<size_t> best;
+    std::vector<uint64_t> candidates(shared.words);
+    size_t starts = std::min<size_t>(byDegree.size(), 256);
+    for (size_t s = 0; s < starts; s++) {
+        std::vector<size_t> clique{byDegree[s]};
+        const uint64_t* row = shared.row(byDegree[s]);
+        std::copy(row, row + shared.words, candidates.begin());
+        while (true) {
+            size_t pick = NodeIndex::npos;
+            for (size_t w = 0; w < shared.words; w++) {
+                for (uint64_t bits = candidates[w]; bits != 0; bits &= bits - 1) {
+                    size_t node = w * 64 + countTrailingZeros(bits);
+                    if (pick == NodeIndex::npos || shared.degree[node] > shared.degree[pick]) {
+                        pick = node;
+                    }
+                }
+            }
+            if (pick == NodeIndex::npos) {
+                break;
+            }
+            clique.push_back(pick);
+            const uint64_t* pickRow = shared.row(pick);
+            for (size_t w = 0; w < shared.words; w++) {
+                candidates[w] &= pickRow[w];
+            }
+        }
+        if (clique.size() > best.size()) {
+            best.swap(clique);
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+ExactColoring Graph::optimalColoring(double timeBudget, size_t threadCount) {
+    threadCount = std::max<size_t>(threadCount, 1);
+    size_t count = graphNodes.size();
+
+    // DSatur gives the first upper bound and the answer whenever the search cannot improve it
+    size_t dsaturColors = coloring(ColoringStrategy::DSatur);
+    ExactColoring result{dsaturColors, dsaturColors, true};
+    if (count == 0) {
+        return result;
+    }
+
+    SharedSearch shared;
+    shared.nodeCount = count;
+    shared.words = (count + 63) / 64;
+    shared.adjacency.assign(count * shared.words, 0);
+    shared.degree.resize(count);
+    shared.best.resize(count);
+    for (size_t slot = 0; slot < count; slot++) {
+        shared.degree[slot] = adjacency[slot].size();
+        shared.best[slot] = graphNodes[slot]->color;
+        for (auto neighbor : adjacency[slot]) {
+            shared.adjacency[slot * shared.words + neighbor / 64] |= uint64_t(1) << (neighbor % 64);
+        }
+    }
+    shared.bound.store(dsaturColors);
+    shared.hasDeadline = timeBudget >= 0;
+    shared.deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(shared.hasDeadline ? timeBudget : 0));
+
+    // clique nodes need distinct colors, fixing them to 1..k removes the symmetric permutations
+    std::vector<size_t> clique = greedyClique(shared, largestFirstOrder());
+    shared.lowerBound = clique.size();
+    for (size_t i = 0; i < clique.size(); i++) {
+        shared.fixed.emplace_back(clique[i], i + 1);
+    }
+
+    if (shared.lowerBound < dsaturColors) {
+        // splits the top of the search tree into subtrees, threads take them one by one
+        std::vector<Search::Path> tasks{Search::Path()};
+        Search splitter(shared);
+        while (tasks.size() < 4 * threadCount) {
+            std::vector<Search::Path> next;
+            bool grew = false;
+            for (auto& task : tasks) {
+                splitter.reset(task);
+                if (splitter.complete()) {
+                    next.push_back(task);
+                    continue;
+                }
+                size_t node = splitter.select();
+                for (size_t color = 1; color <= splitter.colorLimit(); color++) {
+                    if (splitter.allowed(node, color)) {
+                        next.push_back(task);
+                        next.back().emplace_back(node, color);
+                        grew = true;
+                    }
+                }
+            }
+            tasks.swap(next);
+            if (!grew) {
+                break;
+            }
+        }
+
+        std::atomic<size_t> nextTask{0};
+        parallelFor(threadCount, threadCount, [&](size_t, size_t, size_t) {
+            Search search(shared);
+            for (size_t task = nextTask++; task < tasks.size(); task = nextTask++) {
+                search.reset(tasks[task]);
+                search.search();
+            }
+        });
+    }
+
+    storeColors(shared.best);
+    if (incrementalColoring) {
+        trackColors();
+    }
+
+    result.colorCount = shared.bound.load();
+    result.optimal = !shared.timedOut.load();
+    result.lowerBound = result.optimal ? result.colorCount : shared.lowerBound;
+    return result;
+}
+
+size_t Graph::chromaticNumber(size_t threadCount) {
+    return optimalColoring(-1, threadCount).colorCount;
+}
+
+/*** Konec souboru tdd_exact_coloring.cpp ***/
@@ -0,0 +1,157 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_graph_file.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_graph_file.cpp
+ * @author David Bujzaš
+ *
+ * @brief Zápis binárního formátu grafu a jeho čtení z paměťově mapovaného souboru.
+ */
+
+#include "tdd_graph_file.h"
+
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GRAPH_FILE_MMAP 1
+#endif
+
+// writes the arrays of a frozen snapshot followed by the node colors
+void Graph::save(const std::string& path) const {
+    FrozenGraph frozen(*this);
+    std::vector<uint64_t> colors(frozen.nodeCount());
+    for (size_t i = 0; i < colors.size(); i++) {
+        colors[i] = graphNodes[slotOf(frozen.nodeIdAt(i))]->color;
+    }
+
+    GraphFileHeader header;
+    std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.flags = GRAPH_FILE_COLORS;
+    header.nodeCount = frozen.nodeCount();
+    header.neighborCount = frozen.neighborArray().size();
+    header.maxDegree = frozen.graphDegree();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    auto writeArray = [&file](const std::vector<uint64_t>& array) {
+        file.write(reinterpret_cast<const char*>(array.data()),
+                   static_cast<std::streamsize>(array.size() * sizeof(uint64_t)));
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeArray(frozen.idArray());
+    writeArray(frozen.offsetArray());
+    writeArray(frozen.neighborArray());
+    writeArray(colors);
+    if (!file) {
+        throw std::runtime_error("Graph file cannot be written!\n");
+    }
+}
+
+MappedGraph::MappedGraph(const std::string& path, bool verify) {
+#ifdef GRAPH_FILE_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Graph file cannot be opened!\n");
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(GraphFileHeader))) {
+        close(fd);
+        throw std::runtime_error("Graph file is not valid!\n");
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("Graph file cannot be mapped!\n");
+    }
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Graph file cannot be opened!\n");
+    }
+    mappingSize = static_cast<size_t>(file.tellg());
+    mapping = new uint64_t[(mappingSize + 7) / 8];
+    file.seekg(0);
+    file.read(static_cast<char*>(mapping), mappingSize);
+#endif
+
+    // validates the header and that all arrays fit into the file before any query touches them
+    const GraphFileHeader* header = static_cast<const GraphFileHeader*>(mapping);
+    const uint64_t* data = reinterpret_cast<const uint64_t*>(header + 1);
+    size_t words = (mappingSize - sizeof(GraphFileHeader)) / sizeof(uint64_t);
+    bool valid = mappingSize >= sizeof(GraphFileHeader)
+        && std::memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(header->magic)) == 0
+        && header->version == GRAPH_FILE_VERSION;
+    if (valid) {
+        size_t colorWords = (header->flags & GRAPH_FILE_COLORS) ? header->nodeCount : 0;
+        valid = header->nodeCount <= words && header->neighborCount <= words
+            && 2 * header->nodeCount + 1 + header->neighborCount + colorWords <= words;
+        if (valid) {
+            const uint64_t* offsets = data + header->nodeCount;
+            const uint64_t* neighbors = offsets + header->nodeCount + 1;
+            assign(data, offsets, neighbors, header->nodeCount, header->maxDegree);
+            colors = colorWords != 0 ? neighbors + header->neighborCount : nullptr;
+            valid = offsets[header->nodeCount] == header->neighborCount && (!verify || consistent());
+        }
+    }
+    if (!valid) {
+        unmap();
+        throw std::runtime_error("Graph file is not valid!\n");
+    }
+}
+
+bool MappedGraph::consistent() const {
+    if (offsets[0] != 0) {
+        return false;
+    }
+    for (size_t index = 0; index < nodes; index++) {
+        if (index > 0 && ids[index - 1] >= ids[index]) {
+            return false;
+        }
+        if (offsets[index] > offsets[index + 1] || offsets[index + 1] - offsets[index] > maxDegree) {
+            return false;
+        }
+        for (uint64_t i = offsets[index]; i < offsets[index + 1]; i++) {
+            if (neighborIndices[i] >= nodes || (i > offsets[index] && neighborIndices[i - 1] >= neighborIndices[i])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+MappedGraph::~MappedGraph() {
+    unmap();
+}
+
+void MappedGraph::unmap() {
+    if (mapping == nullptr) {
+        return;
+    }
+#ifdef GRAPH_FILE_MMAP
+    munmap(mapping, mappingSize);
+#else
+    delete[] static_cast<uint64_t*>(mapping);
+#endif
+    mapping = nullptr;
+}
+
+size_t MappedGraph::color(size_t nodeId) const {
+    if (colors == nullptr) {
+        throw std::out_of_range("Graph file has no colors!\n");
+    }
+    return colors[checkedIndex(nodeId)];
+}
+
+/*** Konec souboru tdd_graph_file.cpp ***/
@@ -0,0 +1,103 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_graph_file.h
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_graph_file.h
+ * @author David Bujzaš
+ *
+ * @brief Binární formát grafu a jeho čtení přímo z paměťově mapovaného souboru.
+ *
+ * Soubor začíná hlavičkou GraphFileHeader, za kterou následují pole 64bitových čísel v nativním
+ * pořadí bajtů:
+ *  - ids[nodeCount] id uzlů seřazená vzestupně, pozice v poli je hustý index uzlu,
+ *  - offsets[nodeCount + 1] začátky seznamů sousedů,
+ *  - neighbors[neighborCount] husté indexy sousedů, vzestupně v rámci každého uzlu,
+ *  - colors[nodeCount] barvy uzlů, pokud je nastaven příznak GRAPH_FILE_COLORS.
+ */
+#pragma once
+
+#ifndef TDD_GRAPH_FILE_H_
+#define TDD_GRAPH_FILE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "tdd_csr_graph.h"
+
+/** Značka na začátku souboru. */
+#define GRAPH_FILE_MAGIC "IVSGRAPH"
+/** Verze formátu, zvyšuje se při každé nekompatibilní změně. */
+#define GRAPH_FILE_VERSION 1
+/** Příznak přítomnosti pole barev. */
+#define GRAPH_FILE_COLORS 1
+
+/**
+ * @brief Hlavička binárního souboru grafu.
+ */
+struct GraphFileHeader{
+    char magic[8];           ///< GRAPH_FILE_MAGIC bez ukončující nuly
+    uint32_t version;        ///< GRAPH_FILE_VERSION
+    uint32_t flags;          ///< kombinace příznaků GRAPH_FILE_*
+    uint64_t nodeCount;      ///< počet uzlů
+    uint64_t neighborCount;  ///< délka pole sousedů, tedy dvojnásobek počtu hran
+    uint64_t maxDegree;      ///< maximální stupeň uzlu
+};
+
+/**
+ * @brief Graf jen pro čtení obsluhovaný přímo ze stránek paměťově mapovaného souboru.
+ *
+ * Otevření souboru nic nedeserializuje, dotazy čtou pole v souboru. Více procesů tak sdílí jednu kopii
+ * v systémové cache. Na systémech bez mmap je soubor načten do paměti.
+ */
+class MappedGraph : public CsrGraph{
+public:
+    /**
+     * @brief Namapuje soubor vytvořený metodou Graph::save.
+     *
+     * Bez ověření se kontroluje jen hlavička a velikosti polí, otevření tak nečte celý soubor. Poškozený
+     * soubor pak může způsobit čtení mimo pole. S ověřením se v čase O(V + E) zkontroluje, že id rostou,
+     * začátky seznamů neklesají, stupně nepřekračují maximální stupeň a seznamy sousedů obsahují
+     * vzestupně seřazené indexy menší než počet uzlů.
+     *
+     * @param[in] path cesta k souboru
+     * @param[in] verify true pro úplné ověření obsahu souboru
+     * @exception runtime_error pokud soubor nelze otevřít nebo nemá platný formát
+     */
+    explicit MappedGraph(const std::string& path, bool verify = false);
+
+    ~MappedGraph();
+
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+
+    /**
+     * @return true pokud soubor obsahuje barvy uzlů
+     */
+    bool hasColors() const { return colors != nullptr; }
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return barva uzlu uložená v souboru
+     * @exception out_of_range pokud uzel neexistuje nebo soubor neobsahuje barvy
+     */
+    size_t color(size_t nodeId) const;
+
+private:
+    void unmap();
+
+    // checks the content of all arrays, the header checks only guarantee that they fit into the file
+    bool consistent() const;
+
+    void* mapping = nullptr;     ///< začátek namapovaného souboru nebo načtených dat
+    size_t mappingSize = 0;      ///< velikost namapovaného souboru
+    const uint64_t* colors = nullptr;
+};
+
+#endif // TDD_GRAPH_FILE_H_
+
+/*** Konec souboru tdd_graph_file.h ***/
@@ -0,0 +1,175 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_graph_generators.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_graph_generators.cpp
+ * @author David Bujzaš
+ *
+ * @brief Implementace generátorů syntetických grafů.
+ */
+
+#include "tdd_graph_generators.h"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+// the output of mt19937_64 is fixed by the standard, unlike the distributions, so values are
+// derived from raw outputs to keep the graphs identical across standard libraries
+size_t uniformIndex(std::mt19937_64& random, size_t count) {
+    return static_cast<size_t>(random() % count);
+}
+
+double uniformUnit(std::mt19937_64& random) {
+    return static_cast<double>(random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+} // namespace
+
+std::vector<Edge> generateEdges(GraphGenerator generator, size_t nodeCount, size_t averageDegree, uint64_t seed) {
+    size_t edgeCount = nodeCount * averageDegree / 2;
+    switch (generator) {
+        case GraphGenerator::ErdosRenyi:
+            return erdosRenyiEdges(nodeCount, edgeCount, seed);
+        case GraphGenerator::RMat:
+            return rmatEdges(nodeCount, edgeCount, seed);
+        case GraphGenerator::BarabasiAlbert:
+            return barabasiAlbertEdges(nodeCount, std::max<size_t>(averageDegree / 2, 1), seed);
+        case GraphGenerator::Grid:
+            return gridEdges(nodeCount);
+    }
+    return {};
+}
+
+std::vector<Edge> erdosRenyiEdges(size_t nodeCount, size_t edgeCount, uint64_t seed) {
+    std::vector<Edge> edges;
+    if (nodeCount < 2) {
+        return edges;
+    }
+
+    std::mt19937_64 random(seed);
+    edges.reserve(edgeCount);
+    while (edges.size() < edgeCount) {
+        size_t a = uniformIndex(random, nodeCount);
+        size_t b = uniformIndex(random, nodeCount);
+        if (a != b) {
+            edges.emplace_back(a, b);
+        }
+    }
+    return edges;
+}
+
+std::vector<Edge> rmatEdges(size_t nodeCount, size_t edgeCount, uint64_t seed, double a, double b, double c) {
+    std::vector<Edge> edges;
+    if (nodeCount < 2) {
+        return edges;
+    }
+
+    size_t scale = 0;
+    while ((size_t(1) << scale) < nodeCount) {
+        scale++;
+    }
+
+    std::mt19937_64 random(seed);
+    edges.reserve(edgeCount);
+    while (edges.size() < edgeCount) {
+        size_t row = 0;
+        size_t column = 0;
+        for (size_t level = 0; level < scale; level++) {
+            double p = uniformUnit(random);
+            row <<= 1;
+            column <<= 1;
+            if (p < a) {
+                // top left quadrant
+            } else if (p < a + b) {
+                column |= 1;
+            } else if (p < a + b + c) {
+                row |= 1;
+            } else {
+                row |= 1;
+                column |= 1;
+            }
+        }
+        if (row != column && row < nodeCount && column < nodeCount) {
+            edges.emplace_back(row, column);
+        }
+    }
+    return edges;
+}
+
+// every edge adds both endpoints to the list, so a uniform pick from it is proportional to the degree
+std::vector<Edge> barabasiAlbertEdges(size_t nodeCount, size_t edgesPerNode, uint64_t seed) {
+    std::vector<Edge> edges;
+    size_t initial = std::min(nodeCount, edgesPerNode + 1);
+    std::vector<size_t> endpoints;
+    edges.reserve(nodeCount * edgesPerNode);
+    endpoints.reserve(2 * nodeCount * edgesPerNode);
+
+    for (size_t a = 0; a < initial; a++) {
+        for (size_t b = a + 1; b < initial; b++) {
+            edges.emplace_back(a, b);
+            endpoints.push_back(a);
+            endpoints.push_back(b);
+        }
+    }
+
+    std::mt19937_64 random(seed);
+    std::vector<size_t> targets;
+    for (size_t node = initial; node < nodeCount; node++) {
+        targets.clear();
+        while (targets.size() < edgesPerNode) {
+            size_t target = endpoints[uniformIndex(random, endpoints.size())];
+            if (std::find(targets.begin(), targets.end(), target) == targets.end()) {
+                targets.push_back(target);
+            }
+        }
+        for (auto target : targets) {
+            edges.emplace_back(node, target);
+            endpoints.push_back(node);
+            endpoints.push_back(target);
+        }
+    }
+    return edges;
+}
+
+std::vector<Edge> gridEdges(size_t nodeCount) {
+    std::vector<Edge> edges;
+    size_t rows = 1;
+    while ((rows + 1) * (rows + 1) <= nodeCount) {
+        rows++;
+    }
+    size_t columns = (nodeCount + rows - 1) / rows;
+
+    edges.reserve(2 * nodeCount);
+    for (size_t node = 0; node < nodeCount; node++) {
+        if (node % columns + 1 < columns && node + 1 < nodeCount) {
+            edges.emplace_back(node, node + 1);
+        }
+        if (node + columns < nodeCount) {
+            edges.emplace_back(node, node + columns);
+        }
+    }
+    return edges;
+}
+
+const char* generatorName(GraphGenerator generator) {
+    switch (generator) {
+        case GraphGenerator::ErdosRenyi:
+            return "erdos-renyi";
+        case GraphGenerator::RMat:
+            return "rmat";
+        case GraphGenerator::BarabasiAlbert:
+            return "barabasi-albert";
+        case GraphGenerator::Grid:
+            return "grid";
+    }
+    return "unknown";
+}
+
+/*** Konec souboru tdd_graph_generators.cpp ***/
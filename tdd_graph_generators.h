@@ -0,0 +1,79 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_graph_generators.h
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_graph_generators.h
+ * @author David Bujzaš
+ *
+ * @brief Deterministické generátory syntetických grafů pro měření výkonu.
+ */
+#pragma once
+
+#ifndef TDD_GRAPH_GENERATORS_H_
+#define TDD_GRAPH_GENERATORS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "tdd_code.h"
+
+/**
+ * @brief Model náhodného grafu.
+ */
+enum class GraphGenerator{
+    ErdosRenyi,      ///< hrany mezi rovnoměrně náhodnými dvojicemi uzlů
+    RMat,            ///< rekurzivní matice (Kronecker), mocninné rozdělení stupňů a komunity
+    BarabasiAlbert,  ///< preferenční připojování, nové uzly se připojují k uzlům s vysokým stupněm
+    Grid             ///< čtvercová mřížka se čtyřmi sousedy
+};
+
+/**
+ * @brief Vygeneruje hrany grafu s uzly 0 až nodeCount - 1.
+ *
+ * Stejné parametry dávají stejné hrany na všech platformách. Seznam může obsahovat opakované hrany,
+ * nikdy ne smyčky. Uzly bez hran v seznamu chybí, úplný graf vznikne přidáním všech uzlů.
+ *
+ * @param[in] generator model grafu
+ * @param[in] nodeCount počet uzlů
+ * @param[in] averageDegree požadovaný průměrný stupeň, mřížka ho ignoruje
+ * @param[in] seed semínko generátoru náhodných čísel
+ * @return seznam hran
+ */
+std::vector<Edge> generateEdges(GraphGenerator generator, size_t nodeCount, size_t averageDegree, uint64_t seed);
+
+/**
+ * @brief Graf G(n, m), edgeCount hran mezi rovnoměrně náhodnými dvojicemi uzlů.
+ */
+std::vector<Edge> erdosRenyiEdges(size_t nodeCount, size_t edgeCount, uint64_t seed);
+
+/**
+ * @brief Graf R-MAT, každá hrana rekurzivně volí kvadrant matice sousednosti s pravděpodobnostmi a, b, c
+ * a 1 - a - b - c. Hrany s uzlem mimo rozsah se vygenerují znovu.
+ */
+std::vector<Edge> rmatEdges(size_t nodeCount, size_t edgeCount, uint64_t seed, double a = 0.57, double b = 0.19,
+                            double c = 0.19);
+
+/**
+ * @brief Graf Barabási-Albert, začíná klikou edgesPerNode + 1 uzlů a každý další uzel se připojí
+ * k edgesPerNode různým uzlům s pravděpodobností úměrnou jejich stupni.
+ */
+std::vector<Edge> barabasiAlbertEdges(size_t nodeCount, size_t edgesPerNode, uint64_t seed);
+
+/**
+ * @brief Mřížka s floor(sqrt(nodeCount)) řádky, poslední řádek může být neúplný.
+ */
+std::vector<Edge> gridEdges(size_t nodeCount);
+
+/**
+ * @return krátký název generátoru pro výstup měření
+ */
+const char* generatorName(GraphGenerator generator);
+
+#endif // TDD_GRAPH_GENERATORS_H_
+
+/*** Konec souboru tdd_graph_generators.h ***/
@@ -0,0 +1,332 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_graph_log.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_graph_log.cpp
+ * @author David Bujzaš
+ *
+ * @brief Zápis a přehrání žurnálu změn grafu.
+ */
+
+#include "tdd_graph_log.h"
+#include "tdd_graph_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define GRAPH_LOG_FSYNC 1
+#endif
+
+namespace {
+
+const size_t LOG_HEADER_SIZE = 16;  // magic and reserved space for future versions
+
+uint32_t recordChecksum(const GraphLogRecord& record) {
+    uint64_t x = record.a * 0x9E3779B97F4A7C15ULL ^ record.b;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL ^ record.operation;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<uint32_t>(x ^ (x >> 32));
+}
+
+// flushes the stdio buffer and waits until the data reaches the disk
+void syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        throw std::runtime_error("Graph log cannot be written!\n");
+    }
+#ifdef GRAPH_LOG_FSYNC
+    if (fsync(fileno(file)) != 0) {
+        throw std::runtime_error("Graph log cannot be synced!\n");
+    }
+#endif
+}
+
+// makes a rename in the directory durable, failures only weaken durability and are ignored
+void syncDirectory(const std::string& path) {
+#ifdef GRAPH_LOG_FSYNC
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    int fd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+} // namespace
+
+GraphLog::GraphLog(const std::string& basePath, Graph& graph, size_t groupSize, size_t checkpointInterval,
+                   size_t threadCount)
+    : checkpointPath(basePath + ".checkpoint"), logPath(basePath + ".log"), target(graph),
+      groupSize(std::max<size_t>(groupSize, 1)), checkpointInterval(std::max<size_t>(checkpointInterval, 1)) {
+    recover(threadCount);
+}
+
+GraphLog::~GraphLog() {
+    try {
+        commit();
+    } catch (const std::runtime_error&) {
+        // a destructor cannot report the failure, the records stay lost as after a crash
+    }
+    if (log != nullptr) {
+        std::fclose(log);
+    }
+}
+
+void GraphLog::recover(size_t threadCount) {
+    target.clear();
+    if (std::filesystem::exists(checkpointPath)) {
+        loadCheckpoint(threadCount);
+    }
+    if (std::filesystem::exists(logPath)) {
+        replayLog(threadCount);
+        openLog(false);
+    } else {
+        openLog(true);
+    }
+    sinceCheckpoint = replayed;
+}
+
+// nodes first so isolated ones are kept, then every edge once from its lower index
+void GraphLog::loadCheckpoint(size_t threadCount) {
+    MappedGraph mapped(checkpointPath);
+    for (size_t index = 0; index < mapped.nodeCount(); index++) {
+        target.addNode(mapped.nodeIdAt(index));
+    }
+
+    std::vector<Edge> edges;
+    edges.reserve(mapped.edgeCount());
+    for (size_t index = 0; index < mapped.nodeCount(); index++) {
+        for (auto neighbor : mapped.neighborsAt(index)) {
+            if (index < neighbor) {
+                edges.emplace_back(mapped.nodeIdAt(index), mapped.nodeIdAt(neighbor));
+            }
+        }
+    }
+    target.addMultipleEdges(edges, threadCount);
+
+    if (mapped.hasColors()) {
+        for (size_t index = 0; index < mapped.nodeCount(); index++) {
+            size_t nodeId = mapped.nodeIdAt(index);
+            target.getNode(nodeId)->color = mapped.color(nodeId);
+        }
+    }
+}
+
+// runs of additions commute, so they are collected and loaded in bulk before the next removal
+void GraphLog::replayLog(size_t threadCount) {
+    std::ifstream file(logPath, std::ios::binary);
+    char header[LOG_HEADER_SIZE] = {};
+    if (!file.read(header, LOG_HEADER_SIZE) || std::memcmp(header, GRAPH_LOG_MAGIC, 8) != 0) {
+        throw std::runtime_error("Graph log is not valid!\n");
+    }
+
+    std::vector<size_t> nodes;
+    std::vector<Edge> edges;
+    auto flush = [&]() {
+        for (auto nodeId : nodes) {
+            target.addNode(nodeId);
+        }
+        target.addMultipleEdges(edges, threadCount);
+        nodes.clear();
+        edges.clear();
+    };
+
+    // removals of missing elements only happen when the log is replayed over a newer checkpoint
+    GraphLogRecord record;
+    size_t validBytes = LOG_HEADER_SIZE;
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(record)) && record.checksum == recordChecksum(record)) {
+        switch (static_cast<GraphLogOperation>(record.operation)) {
+            case GraphLogOperation::AddNode:
+                nodes.push_back(record.a);
+                break;
+            case GraphLogOperation::AddEdge:
+                edges.emplace_back(record.a, record.b);
+                break;
+            case GraphLogOperation::RemoveNode:
+                flush();
+                if (target.getNode(record.a) != nullptr) {
+                    target.removeNode(record.a);
+                }
+                break;
+            case GraphLogOperation::RemoveEdge:
+                flush();
+                if (target.containsEdge(Edge(record.a, record.b))) {
+                    target.removeEdge(Edge(record.a, record.b));
+                }
+                break;
+            case GraphLogOperation::Clear:
+                nodes.clear();
+                edges.clear();
+                target.clear();
+                break;
+            default:
+                throw std::runtime_error("Graph log is not valid!\n");
+        }
+        validBytes += sizeof(record);
+        replayed++;
+    }
+    flush();
+    file.close();
+
+    // drops a torn record at the end so that new records follow valid ones
+    if (std::filesystem::file_size(logPath) != validBytes) {
+        std::filesystem::resize_file(logPath, validBytes);
+    }
+}
+
+// a new log is written under a temporary name and renamed, so a crash never leaves a log without header
+void GraphLog::openLog(bool truncate) {
+    if (log != nullptr) {
+        std::fclose(log);
+        log = nullptr;
+    }
+
+    if (truncate) {
+        std::string temporary = logPath + ".tmp";
+        std::FILE* file = std::fopen(temporary.c_str(), "wb");
+        if (file == nullptr) {
+            throw std::runtime_error("Graph log cannot be opened!\n");
+        }
+        char header[LOG_HEADER_SIZE] = {};
+        std::memcpy(header, GRAPH_LOG_MAGIC, 8);
+        bool written = std::fwrite(header, 1, LOG_HEADER_SIZE, file) == LOG_HEADER_SIZE;
+        try {
+            syncFile(file);
+        } catch (const std::runtime_error&) {
+            written = false;
+        }
+        std::fclose(file);
+        if (!written || std::rename(temporary.c_str(), logPath.c_str()) != 0) {
+            throw std::runtime_error("Graph log cannot be written!\n");
+        }
+        syncDirectory(logPath);
+    }
+
+    log = std::fopen(logPath.c_str(), "ab");
+    if (log == nullptr) {
+        throw std::runtime_error("Graph log cannot be opened!\n");
+    }
+}
+
+void GraphLog::append(GraphLogOperation operation, uint64_t a, uint64_t b) {
+    GraphLogRecord record{a, b, static_cast<uint32_t>(operation), 0};
+    record.checksum = recordChecksum(record);
+    pending.push_back(record);
+    sinceCheckpoint++;
+
+    if (sinceCheckpoint >= checkpointInterval) {
+        checkpoint();
+    } else if (pending.size() >= groupSize) {
+        commit();
+    }
+}
+
+void GraphLog::commit() {
+    if (pending.empty()) {
+        return;
+    }
+    if (std::fwrite(pending.data(), sizeof(GraphLogRecord), pending.size(), log) != pending.size()) {
+        throw std::runtime_error("Graph log cannot be written!\n");
+    }
+    syncFile(log);
+    syncs++;
+    pending.clear();
+}
+
+// the log is emptied only after the new checkpoint is durable, see the class comment for a crash in between
+void GraphLog::checkpoint() {
+    commit();
+
+    std::string temporary = checkpointPath + ".tmp";
+    target.save(temporary);
+    std::FILE* file = std::fopen(temporary.c_str(), "rb+");
+    if (file == nullptr) {
+        throw std::runtime_error("Graph checkpoint cannot be written!\n");
+    }
+    try {
+        syncFile(file);
+    } catch (const std::runtime_error&) {
+        std::fclose(file);
+        throw;
+    }
+    std::fclose(file);
+    if (std::rename(temporary.c_str(), checkpointPath.c_str()) != 0) {
+        throw std::runtime_error("Graph checkpoint cannot be written!\n");
+    }
+    syncDirectory(checkpointPath);
+
+    openLog(true);
+    sinceCheckpoint = 0;
+}
+
+Node* GraphLog::addNode(size_t nodeId) {
+    Node* node = target.addNode(nodeId);
+    if (node != nullptr) {
+        append(GraphLogOperation::AddNode, nodeId, 0);
+    }
+    return node;
+}
+
+bool GraphLog::addEdge(const Edge& edge) {
+    bool added = target.addEdge(edge);
+    if (added) {
+        append(GraphLogOperation::AddEdge, edge.a, edge.b);
+    }
+    return added;
+}
+
+// logs only the edges that are new, like addEdge, so the replayed tail does not grow with duplicates
+void GraphLog::addMultipleEdges(const std::vector<Edge>& edges) {
+    std::vector<std::pair<size_t, size_t>> keys;
+    keys.reserve(edges.size());
+    for (auto& edge : edges) {
+        if (edge.a != edge.b) {
+            keys.emplace_back(std::min(edge.a, edge.b), std::max(edge.a, edge.b));
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<Edge> added;
+    added.reserve(keys.size());
+    for (auto& key : keys) {
+        Edge edge(key.first, key.second);
+        if (!target.containsEdge(edge)) {
+            added.push_back(edge);
+        }
+    }
+
+    target.addMultipleEdges(added);
+    for (auto& edge : added) {
+        append(GraphLogOperation::AddEdge, edge.a, edge.b);
+    }
+}
+
+void GraphLog::removeNode(size_t nodeId) {
+    target.removeNode(nodeId);
+    append(GraphLogOperation::RemoveNode, nodeId, 0);
+}
+
+void GraphLog::removeEdge(const Edge& edge) {
+    target.removeEdge(edge);
+    append(GraphLogOperation::RemoveEdge, edge.a, edge.b);
+}
+
+void GraphLog::clear() {
+    target.clear();
+    append(GraphLogOperation::Clear, 0, 0);
+}
+
+/*** Konec souboru tdd_graph_log.cpp ***/
@@ -0,0 +1,158 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_graph_log.h
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_graph_log.h
+ * @author David Bujzaš
+ *
+ * @brief Žurnál změn grafu s kontrolními body pro obnovu po pádu.
+ */
+#pragma once
+
+#ifndef TDD_GRAPH_LOG_H_
+#define TDD_GRAPH_LOG_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "tdd_code.h"
+
+/** Značka na začátku žurnálu. */
+#define GRAPH_LOG_MAGIC "IVSGLOG1"
+
+/**
+ * @brief Druh zaznamenané změny.
+ */
+enum class GraphLogOperation : uint32_t{
+    AddNode = 1,
+    AddEdge = 2,
+    RemoveNode = 3,
+    RemoveEdge = 4,
+    Clear = 5
+};
+
+/**
+ * @brief Jeden záznam žurnálu pevné délky.
+ */
+struct GraphLogRecord{
+    uint64_t a;          ///< id uzlu nebo první uzel hrany
+    uint64_t b;          ///< druhý uzel hrany, jinak 0
+    uint32_t operation;  ///< hodnota GraphLogOperation
+    uint32_t checksum;   ///< kontrolní součet předchozích polí, odhalí neúplný zápis
+};
+
+/**
+ * @brief Graf, jehož změny se zapisují do žurnálu jen pro přidávání.
+ *
+ * Stav je uložen ve dvou souborech: kontrolní bod base.checkpoint ve formátu Graph::save a žurnál
+ * base.log se změnami od posledního kontrolního bodu. Záznamy se hromadí v paměti a metoda commit
+ * je zapíše jedním zápisem a jedním fsync (group commit). Změna je trvalá až po commit, ten proběhne
+ * také automaticky po groupSize záznamech a v destruktoru.
+ *
+ * Po checkpointInterval záznamech od posledního kontrolního bodu se uloží nový kontrolní bod a žurnál
+ * se vyprázdní, doba obnovy tak závisí jen na délce žurnálu. Všechny operace nastavují přítomnost
+ * uzlů a hran bez ohledu na předchozí stav, takže opakované přehrání žurnálu nad kontrolním bodem,
+ * který ho už obsahuje (pád mezi uložením kontrolního bodu a vyprázdněním žurnálu), dá stejný graf.
+ * Barvy uzlů se obnoví jen z kontrolního bodu.
+ */
+class GraphLog{
+public:
+    /**
+     * @brief Obnoví graf z kontrolního bodu a žurnálu a otevře žurnál pro další zápis.
+     *
+     * Graf je nejprve vyprázdněn. Kontrolní bod i souvislé běhy přidání v žurnálu se načítají hromadně
+     * přes addMultipleEdges. Neúplný záznam na konci žurnálu je zahozen.
+     *
+     * @param[in] basePath cesta k souborům bez přípony
+     * @param[in, out] graph graf, do kterého se obnoví stav
+     * @param[in] groupSize počet záznamů, po kterém se automaticky provede commit
+     * @param[in] checkpointInterval počet záznamů, po kterém se automaticky uloží kontrolní bod
+     * @param[in] threadCount počet vláken pro hromadné načítání
+     * @exception runtime_error pokud soubory nelze číst nebo zapisovat
+     */
+    GraphLog(const std::string& basePath, Graph& graph, size_t groupSize = 256, size_t checkpointInterval = 1 << 20,
+             size_t threadCount = 1);
+
+    ~GraphLog();
+
+    GraphLog(const GraphLog&) = delete;
+    GraphLog& operator=(const GraphLog&) = delete;
+
+    /**
+     * @brief Změny grafu, chovají se jako stejnojmenné metody Graph. Zaznamenají se jen změny, které
+     * skutečně nastaly, addMultipleEdges tedy nezapíše opakované ani již existující hrany.
+     */
+    Node* addNode(size_t nodeId);
+    bool addEdge(const Edge& edge);
+    void addMultipleEdges(const std::vector<Edge>& edges);
+    void removeNode(size_t nodeId);
+    void removeEdge(const Edge& edge);
+    void clear();
+
+    /**
+     * @brief Zapíše nahromaděné záznamy a počká na fsync.
+     * @exception runtime_error pokud zápis selže
+     */
+    void commit();
+
+    /**
+     * @brief Uloží kontrolní bod a vyprázdní žurnál.
+     * @exception runtime_error pokud zápis selže
+     */
+    void checkpoint();
+
+    /**
+     * @return graf, jen pro čtení, změny musí jít přes GraphLog
+     */
+    const Graph& graph() const { return target; }
+
+    /**
+     * @return počet záznamů přehraných při obnově
+     */
+    size_t replayedRecords() const { return replayed; }
+
+    /**
+     * @return počet záznamů od posledního kontrolního bodu včetně nezapsaných
+     */
+    size_t recordsSinceCheckpoint() const { return sinceCheckpoint; }
+
+    /**
+     * @return počet záznamů čekajících na commit
+     */
+    size_t pendingRecords() const { return pending.size(); }
+
+    /**
+     * @return počet provedených volání fsync žurnálu
+     */
+    size_t syncCount() const { return syncs; }
+
+private:
+    void recover(size_t threadCount);
+    void loadCheckpoint(size_t threadCount);
+    void replayLog(size_t threadCount);
+    void openLog(bool truncate);
+    void append(GraphLogOperation operation, uint64_t a, uint64_t b);
+
+    std::string checkpointPath;
+    std::string logPath;
+    Graph& target;
+    size_t groupSize;
+    size_t checkpointInterval;
+
+    std::FILE* log = nullptr;
+    std::vector<GraphLogRecord> pending;
+    size_t sinceCheckpoint = 0;
+    size_t replayed = 0;
+    size_t syncs = 0;
+};
+
+#endif // TDD_GRAPH_LOG_H_
+
+/*** Konec souboru tdd_graph_log.h ***/
@@ -0,0 +1,136 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_reorder.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_reorder.cpp
+ * @author David Bujzaš
+ *
+ * @brief Implementace přečíslování uzlů pro lepší lokalitu.
+ */
+
+#include "tdd_code.h"
+
+ReorderStats Graph::reorder(ReorderStrategy strategy) {
+    ReorderStats stats;
+    stats.gapBefore = averageGap();
+
+    switch (strategy) {
+        case ReorderStrategy::DegreeDescending:
+            permuteNodes(largestFirstOrder());
+            break;
+        case ReorderStrategy::HubClustering:
+            permuteNodes(hubClusteringOrder());
+            break;
+        case ReorderStrategy::ReverseCuthillMcKee:
+        default:
+            permuteNodes(reverseCuthillMcKeeOrder());
+            break;
+    }
+
+    stats.gapAfter = averageGap();
+    return stats;
+}
+
+double Graph::averageGap() const {
+    if (graphEdges.empty()) {
+        return 0;
+    }
+
+    // every edge is in two lists, so the sum over all lists counts it twice
+    double sum = 0;
+    for (size_t slot = 0; slot < adjacency.size(); slot++) {
+        for (auto neighbor : adjacency[slot]) {
+            sum += neighbor > slot ? neighbor - slot : slot - neighbor;
+        }
+    }
+    return sum / static_cast<double>(2 * graphEdges.size());
+}
+
+// breadth-first search from a node of minimal degree in every component, neighbors are queued
+// by ascending degree
+std::vector<size_t> Graph::reverseCuthillMcKeeOrder() const {
+    size_t count = graphNodes.size();
+    std::vector<size_t> byDegree = largestFirstOrder();
+    std::reverse(byDegree.begin(), byDegree.end());
+
+    std::vector<bool> visited(count, false);
+    std::vector<size_t> order;
+    order.reserve(count);
+    std::vector<size_t> children;
+    for (auto start : byDegree) {
+        if (visited[start]) {
+            continue;
+        }
+        visited[start] = true;
+        order.push_back(start);
+        for (size_t i = order.size() - 1; i < order.size(); i++) {
+            children.clear();
+            for (auto neighbor : adjacency[order[i]]) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    children.push_back(neighbor);
+                }
+            }
+            std::sort(children.begin(), children.end(), [this](size_t a, size_t b) {
+                size_t degreeA = adjacency[a].size();
+                size_t degreeB = adjacency[b].size();
+                return degreeA != degreeB ? degreeA < degreeB : a < b;
+            });
+            order.insert(order.end(), children.begin(), children.end());
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<size_t> Graph::hubClusteringOrder() const {
+    size_t count = graphNodes.size();
+    std::vector<size_t> order;
+    order.reserve(count);
+
+    // a hub has more than the average degree 2E / V
+    auto isHub = [this, count](size_t slot) {
+        return adjacency[slot].size() * count > 2 * graphEdges.size();
+    };
+    for (size_t slot = 0; slot < count; slot++) {
+        if (isHub(slot)) {
+            order.push_back(slot);
+        }
+    }
+    for (size_t slot = 0; slot < count; slot++) {
+        if (!isHub(slot)) {
+            order.push_back(slot);
+        }
+    }
+    return order;
+}
+
+void Graph::permuteNodes(const std::vector<size_t>& order) {
+    size_t count = graphNodes.size();
+    std::vector<size_t> rank(count);
+    for (size_t i = 0; i < count; i++) {
+        rank[order[i]] = i;
+    }
+
+    std::vector<Node*> permuted(count);
+    std::vector<std::vector<size_t>> lists(count);
+    for (size_t i = 0; i < count; i++) {
+        permuted[i] = graphNodes[order[i]];
+        lists[i] = std::move(adjacency[order[i]]);
+        for (auto& neighbor : lists[i]) {
+            neighbor = rank[neighbor];
+        }
+        std::sort(lists[i].begin(), lists[i].end());
+        nodeIndex.assign(permuted[i]->id, i);
+    }
+    graphNodes.swap(permuted);
+    adjacency.swap(lists);
+}
+
+/*** Konec souboru tdd_reorder.cpp ***/
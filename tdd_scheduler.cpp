@@ -0,0 +1,165 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_scheduler.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_scheduler.cpp
+ * @author David Bujzaš
+ *
+ * @brief Implementace plánovače úloh po třídách barev.
+ */
+
+#include "tdd_scheduler.h"
+
+#include <chrono>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+ColorScheduler::ColorScheduler(size_t threadCount) {
+    threadCount = std::max<size_t>(threadCount, 1);
+    ranges.reset(new Range[threadCount]);
+    for (size_t worker = 0; worker + 1 < threadCount; worker++) {
+        workers.emplace_back(&ColorScheduler::workerLoop, this, worker);
+    }
+}
+
+ColorScheduler::~ColorScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ColorScheduler::workerLoop(size_t worker) {
+    size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        runBatch(worker);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--active == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+// drains the own range first, then takes the remaining tasks of the other ranges
+void ColorScheduler::runBatch(size_t worker) {
+    size_t count = threadCount();
+    for (size_t offset = 0; offset < count; offset++) {
+        Range& range = ranges[(worker + offset) % count];
+        for (size_t i = range.next.fetch_add(1); i < range.end; i = range.next.fetch_add(1)) {
+            if (offset != 0) {
+                steals.fetch_add(1, std::memory_order_relaxed);
+            }
+            try {
+                (*currentTask)(batch[i]);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+    }
+}
+
+ScheduleStats ColorScheduler::run(const Graph& graph, const std::function<void(size_t)>& task) {
+    auto start = Clock::now();
+    Span<Node*> nodes = graph.nodesView();
+
+    // a node of every color goes to its class by counting sort, the order inside a class is the node order
+    size_t maxColor = 0;
+    for (auto node : nodes) {
+        if (node->color == 0 || node->color == static_cast<size_t>(-1)) {
+            throw std::runtime_error("Graph is not colored!\n");
+        }
+        maxColor = std::max(maxColor, node->color);
+    }
+    for (auto& edge : graph.edgesView()) {
+        if (nodes[graph.indexOf(edge.a)]->color == nodes[graph.indexOf(edge.b)]->color) {
+            throw std::runtime_error("Graph coloring is not valid!\n");
+        }
+    }
+
+    std::vector<size_t> classStart(maxColor + 2, 0);
+    for (auto node : nodes) {
+        classStart[node->color + 1]++;
+    }
+    for (size_t color = 1; color < classStart.size(); color++) {
+        classStart[color] += classStart[color - 1];
+    }
+    std::vector<size_t> ordered(nodes.size());
+    std::vector<size_t> position(classStart.begin(), classStart.end() - 1);
+    for (auto node : nodes) {
+        ordered[position[node->color]++] = node->id;
+    }
+
+    ScheduleStats stats;
+    currentTask = &task;
+    size_t count = threadCount();
+    for (size_t color = 1; color <= maxColor; color++) {
+        size_t begin = classStart[color];
+        size_t size = classStart[color + 1] - begin;
+        if (size == 0) {
+            continue;
+        }
+
+        auto classStartTime = Clock::now();
+        batch = ordered.data() + begin;
+        steals.store(0, std::memory_order_relaxed);
+        for (size_t worker = 0; worker < count; worker++) {
+            ranges[worker].next.store(size * worker / count, std::memory_order_relaxed);
+            ranges[worker].end = size * (worker + 1) / count;
+        }
+
+        // the mutex publishes the ranges to the workers, the caller runs the last range itself
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            active = workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        runBatch(count - 1);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [this] { return active == 0; });
+        }
+
+        stats.classes.push_back(ColorClassStats{color, size, steals.load(), secondsSince(classStartTime)});
+        if (failure) {
+            std::exception_ptr error = failure;
+            failure = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    stats.seconds = secondsSince(start);
+    return stats;
+}
+
+/*** Konec souboru tdd_scheduler.cpp ***/
@@ -0,0 +1,116 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_scheduler.h
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_scheduler.h
+ * @author David Bujzaš
+ *
+ * @brief Paralelní spouštění úloh po třídách barev grafu konfliktů.
+ */
+#pragma once
+
+#ifndef TDD_SCHEDULER_H_
+#define TDD_SCHEDULER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tdd_code.h"
+
+/**
+ * @brief Statistika jedné třídy barev.
+ */
+struct ColorClassStats{
+    size_t color;      ///< barva třídy
+    size_t taskCount;  ///< počet úloh ve třídě
+    size_t steals;     ///< počet úloh provedených jiným než přiděleným vláknem
+    double seconds;    ///< doba od spuštění třídy po bariéru
+};
+
+/**
+ * @brief Statistika jednoho běhu plánovače.
+ */
+struct ScheduleStats{
+    std::vector<ColorClassStats> classes;  ///< třídy v pořadí spuštění, tedy vzestupně podle barvy
+    double seconds;                        ///< celková doba běhu
+};
+
+/**
+ * @brief Plánovač, který spouští úlohy grafu konfliktů po třídách barev.
+ *
+ * Uzly grafu jsou úlohy a hrana znamená sdílený prostředek. V platném obarvení nemají uzly stejné barvy
+ * žádný společný prostředek, takže třída barvy běží paralelně bez zámků mezi úlohami a mezi třídami
+ * je jen bariéra. Úlohy třídy jsou rozděleny na souvislé úseky, jeden na vlákno. Vlákno, které svůj
+ * úsek dokončí, bere úlohy z úseků ostatních vláken přes jejich atomický čítač.
+ *
+ * Vlákna vznikají jednou v konstruktoru a mezi běhy spí. Volající vlákno pracuje jako jedno z nich.
+ */
+class ColorScheduler{
+public:
+    /**
+     * @param[in] threadCount počet vláken včetně volajícího
+     */
+    explicit ColorScheduler(size_t threadCount);
+
+    ~ColorScheduler();
+
+    ColorScheduler(const ColorScheduler&) = delete;
+    ColorScheduler& operator=(const ColorScheduler&) = delete;
+
+    /**
+     * Spustí úlohu pro každý uzel grafu, třídy barev postupně od nejnižší barvy. Výjimka z úlohy
+     * dokončí aktuální třídu a je předána volajícímu, další třídy se nespustí.
+     *
+     * @param[in] graph obarvený graf konfliktů
+     * @param[in] task úloha volaná s id uzlu
+     * @return statistika tříd
+     * @exception runtime_error pokud některý uzel není obarven nebo hrana spojuje uzly stejné barvy
+     */
+    ScheduleStats run(const Graph& graph, const std::function<void(size_t)>& task);
+
+    /**
+     * @return počet vláken včetně volajícího
+     */
+    size_t threadCount() const { return workers.size() + 1; }
+
+private:
+    /**
+     * @brief Úsek úloh třídy přidělený jednomu vláknu, zarovnaný kvůli false sharingu čítačů.
+     */
+    struct alignas(64) Range{
+        std::atomic<size_t> next{0};
+        size_t end = 0;
+    };
+
+    void workerLoop(size_t worker);
+    void runBatch(size_t worker);
+
+    std::vector<std::thread> workers;
+    std::unique_ptr<Range[]> ranges;
+
+    std::mutex mutex;                    ///< chrání jen uspávání vláken a předání chyby
+    std::condition_variable wake;
+    std::condition_variable finished;
+    size_t generation = 0;               ///< číslo aktuální třídy, vlákna na jeho změnu čekají
+    size_t active = 0;                   ///< počet pomocných vláken, která třídu ještě nedokončila
+    bool stopping = false;
+
+    const size_t* batch = nullptr;       ///< id uzlů aktuální třídy
+    const std::function<void(size_t)>* currentTask = nullptr;
+    std::atomic<size_t> steals{0};
+    std::exception_ptr failure;
+};
+
+#endif // TDD_SCHEDULER_H_
+
+/*** Konec souboru tdd_scheduler.h ***/
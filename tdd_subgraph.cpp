@@ -0,0 +1,119 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_subgraph.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_subgraph.cpp
+ * @author David Bujzaš
+ *
+ * @brief Implementace pohledu na indukovaný podgraf.
+ */
+
+#include "tdd_subgraph.h"
+
+SubgraphView::SubgraphView(const Graph& graph) : graph(graph), bitmap((graph.nodeCount() + 63) / 64, 0) {
+}
+
+SubgraphView::SubgraphView(const Graph& graph, const std::vector<size_t>& nodeIds) : SubgraphView(graph) {
+    for (auto nodeId : nodeIds) {
+        size_t slot = graph.indexOf(nodeId);
+        if (slot == NodeIndex::npos) {
+            throw std::out_of_range("Node does not exist!\n");
+        }
+        bitmap[slot / 64] |= uint64_t(1) << (slot % 64);
+    }
+    collectMembers();
+}
+
+// the bitmap doubles as the visited set, so only the ego network itself is touched
+SubgraphView SubgraphView::egoNetwork(const Graph& graph, size_t centerId, size_t hops) {
+    size_t center = graph.indexOf(centerId);
+    if (center == NodeIndex::npos) {
+        throw std::out_of_range("Node does not exist!\n");
+    }
+
+    SubgraphView view(graph);
+    view.bitmap[center / 64] |= uint64_t(1) << (center % 64);
+    std::vector<size_t> frontier{center};
+    std::vector<size_t> next;
+    for (size_t level = 0; level < hops && !frontier.empty(); level++) {
+        next.clear();
+        for (auto slot : frontier) {
+            for (auto neighbor : graph.neighborsAt(slot)) {
+                if (!view.isMember(neighbor)) {
+                    view.bitmap[neighbor / 64] |= uint64_t(1) << (neighbor % 64);
+                    next.push_back(neighbor);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    view.collectMembers();
+    return view;
+}
+
+void SubgraphView::collectMembers() {
+    wordRanks.resize(bitmap.size());
+    for (size_t w = 0; w < bitmap.size(); w++) {
+        wordRanks[w] = members.size();
+        for (uint64_t bits = bitmap[w]; bits != 0; bits &= bits - 1) {
+            members.push_back(w * 64 + countTrailingZeros(bits));
+        }
+    }
+
+    degrees.resize(members.size());
+    size_t endpoints = 0;
+    for (size_t index = 0; index < members.size(); index++) {
+        size_t degree = 0;
+        for (auto neighbor : graph.neighborsAt(members[index])) {
+            degree += isMember(neighbor);
+        }
+        degrees[index] = degree;
+        endpoints += degree;
+        maxDegree = std::max(maxDegree, degree);
+    }
+    edges = endpoints / 2;
+}
+
+size_t SubgraphView::indexOf(size_t nodeId) const {
+    size_t slot = graph.indexOf(nodeId);
+    return slot != NodeIndex::npos && isMember(slot) ? memberIndex(slot) : NodeIndex::npos;
+}
+
+bool SubgraphView::containsEdge(const Edge& edge) const {
+    return containsNode(edge.a) && containsNode(edge.b) && graph.containsEdge(edge);
+}
+
+size_t SubgraphView::nodeDegree(size_t nodeId) const {
+    size_t index = indexOf(nodeId);
+    if (index == NodeIndex::npos) {
+        throw std::out_of_range("Node does not exist!\n");
+    }
+    return degrees[index];
+}
+
+size_t SubgraphView::coloring(size_t* colors) const {
+    // color 0 means uncolored, so neighbors later in the order never forbid anything
+    std::fill(colors, colors + members.size(), 0);
+
+    ColorMask mask;
+    mask.reset(maxDegree + 1);
+    size_t colorCount = 0;
+    for (size_t index = 0; index < members.size(); index++) {
+        forEachNeighbor(index, [&](size_t neighbor) { mask.forbid(colors[neighbor]); });
+        colors[index] = mask.firstFree();
+        colorCount = std::max(colorCount, colors[index]);
+        forEachNeighbor(index, [&](size_t neighbor) { mask.allow(colors[neighbor]); });
+    }
+    return colorCount;
+}
+
+FrozenGraph SubgraphView::freeze() const {
+    return FrozenGraph(*this);
+}
+
+/*** Konec souboru tdd_subgraph.cpp ***/
@@ -0,0 +1,163 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_subgraph.h
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_subgraph.h
+ * @author David Bujzaš
+ *
+ * @brief Pohled na indukovaný podgraf bez kopírování hran.
+ */
+#pragma once
+
+#ifndef TDD_SUBGRAPH_H_
+#define TDD_SUBGRAPH_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "tdd_csr_graph.h"
+
+/**
+ * @brief Indukovaný podgraf nad vybranými uzly grafu.
+ *
+ * Pohled drží jen bitovou mapu vybraných uzlů přes indexy grafu (viz Graph::indexOf) s počty vybraných
+ * uzlů před každým slovem mapy, seřazený seznam těchto indexů a stupně uzlů v podgrafu. Hustý index
+ * souseda se tak zjistí v konstantním čase. Hrany čte přímo ze seznamů sousedů grafu a sousedy mimo
+ * výběr přeskakuje podle bitové mapy. Uzly pohledu mají husté indexy 0 až nodeCount() - 1 v pořadí
+ * indexů v grafu. Pohled platí, dokud se graf nezmění.
+ */
+class SubgraphView{
+public:
+    /**
+     * @brief Vytvoří podgraf indukovaný danými uzly, opakovaná id jsou ignorována.
+     * @param[in] graph graf
+     * @param[in] nodeIds id vybraných uzlů
+     * @exception out_of_range pokud některý z uzlů v grafu neexistuje
+     */
+    SubgraphView(const Graph& graph, const std::vector<size_t>& nodeIds);
+
+    /**
+     * @brief Vytvoří podgraf indukovaný uzly ve vzdálenosti nejvýše hops od středu (ego síť).
+     *
+     * Prohledávání do šířky se zastaví po hops vrstvách, takže neprochází zbytek komponenty.
+     *
+     * @param[in] graph graf
+     * @param[in] centerId id středového uzlu
+     * @param[in] hops maximální vzdálenost od středu
+     * @return pohled na ego síť
+     * @exception out_of_range pokud středový uzel v grafu neexistuje
+     */
+    static SubgraphView egoNetwork(const Graph& graph, size_t centerId, size_t hops);
+
+    /**
+     * @return počet uzlů v podgrafu
+     */
+    size_t nodeCount() const { return members.size(); }
+
+    /**
+     * @return počet hran v podgrafu
+     */
+    size_t edgeCount() const { return edges; }
+
+    /**
+     * @return maximální stupeň uzlu v podgrafu
+     */
+    size_t graphDegree() const { return maxDegree; }
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return hustý index uzlu v podgrafu nebo NodeIndex::npos, pokud uzel v podgrafu není
+     */
+    size_t indexOf(size_t nodeId) const;
+
+    /**
+     * @param[in] index hustý index uzlu v podgrafu
+     * @return id uzlu
+     */
+    size_t nodeIdAt(size_t index) const { return graph.nodeIdAt(members[index]); }
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return true pokud uzel patří do podgrafu
+     */
+    bool containsNode(size_t nodeId) const { return indexOf(nodeId) != NodeIndex::npos; }
+
+    /**
+     * @param[in] edge hrana, která nás zajímá
+     * @return true pokud oba uzly patří do podgrafu a hrana existuje v grafu
+     */
+    bool containsEdge(const Edge& edge) const;
+
+    /**
+     * @param[in] nodeId id uzlu
+     * @return stupeň uzlu v podgrafu
+     * @exception out_of_range pokud uzel v podgrafu není
+     */
+    size_t nodeDegree(size_t nodeId) const;
+
+    /**
+     * @param[in] index hustý index uzlu v podgrafu
+     * @return stupeň uzlu v podgrafu
+     */
+    size_t degreeAt(size_t index) const { return degrees[index]; }
+
+    /**
+     * @brief Zavolá funkci pro hustý index každého souseda uzlu uvnitř podgrafu.
+     * @param[in] index hustý index uzlu v podgrafu
+     * @param[in] function funkce volaná jako function(index souseda)
+     */
+    template<typename Function>
+    void forEachNeighbor(size_t index, Function function) const{
+        for (auto neighbor : graph.neighborsAt(members[index])) {
+            if (isMember(neighbor)) {
+                function(memberIndex(neighbor));
+            }
+        }
+    }
+
+    /**
+     * Hladově obarví uzly v pořadí hustých indexů. Graf se nemění, barvy jsou zapsány do pole volajícího.
+     * Nepoužije více než graphDegree + 1 barev.
+     *
+     * @param[out] colors barva od 1 pro každý hustý index uzlu, pole musí mít alespoň nodeCount() prvků
+     * @return počet použitých barev
+     */
+    size_t coloring(size_t* colors) const;
+
+    /**
+     * @brief Zkopíruje podgraf do nezávislého snímku ve formátu CSR.
+     * @return snímek s uzly a hranami podgrafu
+     */
+    FrozenGraph freeze() const;
+
+private:
+    explicit SubgraphView(const Graph& graph);
+
+    // fills members and word ranks from the bitmap and computes the degrees
+    void collectMembers();
+
+    bool isMember(size_t slot) const { return (bitmap[slot / 64] >> (slot % 64) & 1) != 0; }
+
+    // members are in slot order, so the dense index is the number of set bits before the slot
+    size_t memberIndex(size_t slot) const{
+        uint64_t below = bitmap[slot / 64] & ((uint64_t(1) << (slot % 64)) - 1);
+        return wordRanks[slot / 64] + countSetBits(below);
+    }
+
+    const Graph& graph;
+    std::vector<uint64_t> bitmap;     ///< bit pro každý index uzlu v grafu
+    std::vector<size_t> wordRanks;    ///< počet vybraných uzlů ve slovech bitové mapy před daným slovem
+    std::vector<size_t> members;      ///< vzestupně seřazené indexy vybraných uzlů v grafu
+    std::vector<size_t> degrees;      ///< stupně v podgrafu indexované hustým indexem
+    size_t edges = 0;
+    size_t maxDegree = 0;
+};
+
+#endif // TDD_SUBGRAPH_H_
+
+/*** Konec souboru tdd_subgraph.h ***/
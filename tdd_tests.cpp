@@ -18,6 +18,16 @@
 #include "gtest/gtest.h"
 #include <gmock/gmock.h>
 #include "tdd_code.h"
+#include "tdd_compressed_graph.h"
+#include "tdd_concurrent_graph.h"
+#include "tdd_csr_graph.h"
+#include "tdd_graph_file.h"
+#include "tdd_graph_generators.h"
+#include "tdd_graph_log.h"
+#include "tdd_scheduler.h"
+#include "tdd_subgraph.h"
+#include <cstdio>
+#include <fstream>
 
 using namespace ::testing;
 
@@ -352,4 +362,1215 @@ TEST(Edges, toStringStream){
     EXPECT_EQ(ss.str(), "{1, 4}");
 }
 
+TEST_F(NonEmptyGraph, removeNodeUpdatesNeighbors){
+    graph.removeNode(5);
+    EXPECT_FALSE(graph.containsEdge(Edge(1, 5)));
+    EXPECT_FALSE(graph.containsEdge(Edge(6, 5)));
+    EXPECT_EQ(graph.nodeDegree(1), 1);
+    EXPECT_EQ(graph.nodeDegree(6), 2);
+    EXPECT_EQ(graph.nodeDegree(7), 1);
+    EXPECT_EQ(graph.edgeCount(), 3);
+
+    EXPECT_TRUE(graph.addEdge(Edge(5, 1)));
+    EXPECT_TRUE(graph.containsEdge(Edge(1, 5)));
+    EXPECT_EQ(graph.nodeDegree(5), 1);
+}
+
+TEST_F(NonEmptyGraph, removeEdgeUpdatesDegree){
+    graph.removeEdge(Edge(6, 5));
+    EXPECT_FALSE(graph.containsEdge(Edge(5, 6)));
+    EXPECT_EQ(graph.nodeDegree(5), 2);
+    EXPECT_EQ(graph.nodeDegree(6), 2);
+    EXPECT_TRUE(graph.containsEdge(Edge(7, 6)));
+
+    EXPECT_TRUE(graph.addEdge(Edge(5, 6)));
+    EXPECT_EQ(graph.edgeCount(), 6);
+}
+
+
+TEST_F(EmptyGraph, addRemoveManyNodes){
+    for (size_t id = 0; id < 1000; id++){
+        ASSERT_NE(graph.addNode(id * 7919), nullptr);
+    }
+    for (size_t id = 0; id < 1000; id += 3){
+        graph.removeNode(id * 7919);
+    }
+
+    EXPECT_EQ(graph.nodeCount(), 666);
+    for (size_t id = 0; id < 1000; id++){
+        Node* node = graph.getNode(id * 7919);
+        if (id % 3 == 0){
+            EXPECT_EQ(node, nullptr);
+        } else {
+            ASSERT_NE(node, nullptr);
+            EXPECT_EQ(node->id, id * 7919);
+        }
+    }
+}
+
+TEST(NodeIndex, insertFindErase){
+    NodeIndex index;
+    EXPECT_EQ(index.find(5), NodeIndex::npos);
+    EXPECT_FALSE(index.erase(5));
+
+    for (size_t key = 0; key < 100; key++){
+        EXPECT_TRUE(index.insert(key << 32, key));
+    }
+    EXPECT_FALSE(index.insert(0, 1));
+    EXPECT_EQ(index.size(), 100);
+
+    for (size_t key = 0; key < 100; key += 2){
+        EXPECT_TRUE(index.erase(key << 32));
+    }
+    for (size_t key = 0; key < 100; key++){
+        EXPECT_EQ(index.find(key << 32), key % 2 ? key : NodeIndex::npos);
+    }
+
+    index.assign(1ULL << 32, 42);
+    EXPECT_EQ(index.find(1ULL << 32), 42);
+}
+
+TEST_F(EmptyGraph, nodeAddressesAreStable){
+    Node* first = graph.addNode(0);
+    for (size_t id = 1; id < 3 * NodeArena::CHUNK_SIZE; id++){
+        graph.addNode(id);
+    }
+    EXPECT_EQ(graph.getNode(0), first);
+    EXPECT_EQ(first->id, 0);
+
+    Node* removed = graph.getNode(10);
+    graph.removeNode(10);
+    EXPECT_EQ(graph.addNode(10), removed);
+    EXPECT_EQ(graph.getNode(0), first);
+}
+
+TEST(NodeArena, reuseAndClear){
+    NodeArena arena;
+    EXPECT_EQ(arena.chunkCount(), 0);
+
+    Node* a = arena.allocate();
+    Node* b = arena.allocate();
+    EXPECT_EQ(b, a + 1);
+    EXPECT_EQ(arena.chunkCount(), 1);
+
+    arena.release(a);
+    EXPECT_EQ(arena.allocate(), a);
+
+    arena.clear();
+    EXPECT_EQ(arena.chunkCount(), 0);
+}
+
+TEST_F(NonEmptyGraph, graphDegreeAfterUpdates){
+    graph.addMultipleEdges({{5, 8}, {5, 9}});
+    EXPECT_EQ(graph.graphDegree(), 5);
+
+    graph.removeEdge(Edge(5, 9));
+    EXPECT_EQ(graph.graphDegree(), 4);
+
+    graph.removeNode(5);
+    EXPECT_EQ(graph.graphDegree(), 2);
+
+    graph.removeNode(6);
+    EXPECT_EQ(graph.graphDegree(), 1);
+
+    graph.clear();
+    EXPECT_EQ(graph.graphDegree(), 0);
+    graph.addNode(1);
+    EXPECT_EQ(graph.graphDegree(), 0);
+}
+
+TEST_F(EmptyGraph, coloringLargeGraph){
+    // pseudo-random graph with a few high degree hubs
+    size_t state = 12345;
+    for (size_t i = 0; i < 5000; i++){
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        size_t a = (state >> 33) % 700;
+        size_t b = (state >> 13) % (a % 10 == 0 ? 700 : 50);
+        graph.addEdge(Edge(a, b));
+    }
+
+    graph.coloring();
+    size_t maxColor = 0;
+    for (auto node : graph.nodes()){
+        EXPECT_GE(node->color, 1);
+        maxColor = std::max(maxColor, node->color);
+    }
+    EXPECT_LE(maxColor, graph.graphDegree() + 1);
+
+    for (auto edge : graph.edges()){
+        EXPECT_NE(graph.getNode(edge.a)->color, graph.getNode(edge.b)->color);
+    }
+}
+
+TEST(ColorMask, firstFree){
+    ColorMask mask;
+    mask.reset(130);
+    EXPECT_EQ(mask.firstFree(), 1);
+
+    for (size_t color = 1; color <= 70; color++){
+        mask.forbid(color);
+    }
+    mask.forbid(500);
+    EXPECT_EQ(mask.firstFree(), 71);
+
+    mask.allow(5);
+    EXPECT_EQ(mask.firstFree(), 5);
+
+    for (size_t color = 1; color <= 130; color++){
+        mask.forbid(color);
+    }
+    EXPECT_EQ(mask.firstFree(), 131);
+}
+
+/**
+ * @brief Ověří, že obarvení je platné a použije nejvýše graphDegree + 1 barev.
+ */
+static void expectValidColoring(Graph& graph, size_t colorCount){
+    size_t maxColor = 0;
+    for (auto node : graph.nodes()){
+        EXPECT_GE(node->color, 1);
+        maxColor = std::max(maxColor, node->color);
+    }
+    EXPECT_EQ(maxColor, colorCount);
+    EXPECT_LE(colorCount, graph.graphDegree() + 1);
+
+    for (auto edge : graph.edges()){
+        EXPECT_NE(graph.getNode(edge.a)->color, graph.getNode(edge.b)->color);
+    }
+}
+
+TEST_F(NonEmptyGraph, coloringStrategies){
+    for (auto strategy : {ColoringStrategy::InsertionOrder, ColoringStrategy::LargestFirst,
+                          ColoringStrategy::SmallestLast, ColoringStrategy::DSatur}){
+        expectValidColoring(graph, graph.coloring(strategy));
+    }
+}
+
+TEST_F(EmptyGraph, coloringStrategiesOnCrown){
+    // crown graph is bipartite, DSatur and smallest-last find the two colors
+    for (size_t i = 0; i < 6; i++){
+        for (size_t j = 0; j < 6; j++){
+            if (i != j){
+                graph.addEdge(Edge(2 * i, 2 * j + 1));
+            }
+        }
+    }
+
+    expectValidColoring(graph, graph.coloring(ColoringStrategy::InsertionOrder));
+    EXPECT_EQ(graph.coloring(ColoringStrategy::DSatur), 2);
+    EXPECT_EQ(graph.coloring(ColoringStrategy::SmallestLast), 2);
+    expectValidColoring(graph, graph.coloring(ColoringStrategy::LargestFirst));
+}
+
+TEST_F(EmptyGraph, smallestLastColorsTreeWithTwoColors){
+    for (size_t id = 1; id < 200; id++){
+        graph.addEdge(Edge(id, id / 2));
+    }
+
+    EXPECT_EQ(graph.coloring(ColoringStrategy::SmallestLast), 2);
+    expectValidColoring(graph, 2);
+    EXPECT_EQ(graph.coloring(ColoringStrategy::DSatur), 2);
+}
+
+TEST_F(EmptyGraph, parallelColoringIsDeterministic){
+    size_t state = 777;
+    for (size_t i = 0; i < 4000; i++){
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        graph.addEdge(Edge((state >> 33) % 500, (state >> 17) % 500));
+    }
+
+    size_t colorCount = graph.parallelColoring(1, 42);
+    expectValidColoring(graph, colorCount);
+    std::vector<size_t> expected;
+    for (auto node : graph.nodes()){
+        expected.push_back(node->color);
+    }
+
+    for (size_t threads : {2, 4, 7}){
+        EXPECT_EQ(graph.parallelColoring(threads, 42), colorCount);
+        std::vector<size_t> colors;
+        for (auto node : graph.nodes()){
+            colors.push_back(node->color);
+        }
+        EXPECT_EQ(colors, expected);
+    }
+
+    expectValidColoring(graph, graph.parallelColoring(4, 43));
+}
+
+TEST_F(NonEmptyGraph, parallelColoring){
+    expectValidColoring(graph, graph.parallelColoring(3));
+}
+
+TEST_F(EmptyGraph, parallelColoring){
+    EXPECT_EQ(graph.parallelColoring(4), 0);
+}
+
+TEST_F(NonEmptyGraph, incrementalColoring){
+    graph.setIncrementalColoring(true);
+    expectValidColoring(graph, graph.colorCount());
+
+    graph.addMultipleEdges({{1, 6}, {4, 5}, {4, 7}, {1, 7}, {8, 1}, {8, 4}, {8, 5}});
+    expectValidColoring(graph, graph.colorCount());
+
+    graph.addNode(9);
+    EXPECT_EQ(graph.getNode(9)->color, 1);
+    graph.removeNode(8);
+    expectValidColoring(graph, graph.colorCount());
+
+    graph.setIncrementalColoring(false);
+    graph.addEdge(Edge(10, 11));
+    EXPECT_EQ(graph.getNode(10)->color, 0);
+}
+
+TEST_F(EmptyGraph, incrementalColoringDriftTriggersRecolor){
+    // two stars whose centers share a color until they get connected
+    graph.addMultipleEdges({{1, 2}, {1, 3}, {4, 5}, {4, 6}});
+    graph.setIncrementalColoring(true, 0, ColoringStrategy::DSatur);
+    EXPECT_EQ(graph.colorCount(), 2);
+
+    size_t state = 99;
+    for (size_t i = 0; i < 2000; i++){
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        graph.addEdge(Edge((state >> 33) % 300, (state >> 17) % 300));
+        ASSERT_LE(graph.colorCount(), graph.graphDegree() + 1);
+    }
+    expectValidColoring(graph, graph.colorCount());
+}
+
+TEST_F(EmptyGraph, addMultipleEdgesBulk){
+    // enough edges to take the radix sort path, ids use the high bits as well
+    std::vector<Edge> edges;
+    std::set<std::pair<size_t, size_t>> expected;
+    size_t state = 2024;
+    for (size_t i = 0; i < 80000; i++){
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        size_t a = ((state >> 40) % 3000) << 40 | (state >> 50);
+        size_t b = (state >> 24) % 3000;
+        edges.emplace_back(a, b);
+        if (a != b){
+            expected.emplace(std::min(a, b), std::max(a, b));
+        }
+    }
+    graph.addEdge(edges[0]);
+
+    graph.addMultipleEdges(edges, 3);
+    EXPECT_EQ(graph.edgeCount(), expected.size());
+    for (auto& edge : expected){
+        ASSERT_TRUE(graph.containsEdge(Edge(edge.second, edge.first)));
+    }
+
+    size_t degreeSum = 0;
+    size_t maxDegree = 0;
+    for (auto node : graph.nodes()){
+        degreeSum += graph.nodeDegree(node->id);
+        maxDegree = std::max(maxDegree, graph.nodeDegree(node->id));
+    }
+    EXPECT_EQ(degreeSum, 2 * expected.size());
+    EXPECT_EQ(graph.graphDegree(), maxDegree);
+
+    Graph sequential;
+    sequential.addMultipleEdges(edges);
+    EXPECT_EQ(sequential.edgeCount(), expected.size());
+    EXPECT_EQ(sequential.nodeCount(), graph.nodeCount());
+}
+
+
+TEST_F(NonEmptyGraph, views){
+    auto nodes = graph.nodesView();
+    EXPECT_EQ(nodes.size(), 5);
+    EXPECT_THAT(std::vector<Node*>(nodes.begin(), nodes.end()), UnorderedElementsAre(Field(&Node::id, 1),
+                                                                                    Field(&Node::id, 4),
+                                                                                    Field(&Node::id, 5),
+                                                                                    Field(&Node::id, 6),
+                                                                                    Field(&Node::id, 7)));
+
+    auto edges = graph.edgesView();
+    EXPECT_THAT(std::vector<Edge>(edges.begin(), edges.end()),
+                UnorderedElementsAre(Eq(Edge(1, 4)), Eq(Edge(1, 5)), Eq(Edge(4, 6)), Eq(Edge(5, 6)),
+                                     Eq(Edge(5, 7)), Eq(Edge(7, 6))));
+
+    auto neighbors = graph.neighbors(5);
+    EXPECT_THAT(std::vector<size_t>(neighbors.begin(), neighbors.end()), UnorderedElementsAre(1, 6, 7));
+    EXPECT_THROW(graph.neighbors(9), std::out_of_range);
+}
+
+TEST_F(EmptyGraph, views){
+    EXPECT_TRUE(graph.nodesView().empty());
+    EXPECT_TRUE(graph.edgesView().empty());
+    graph.addNode(1);
+    EXPECT_TRUE(graph.neighbors(1).empty());
+}
+
+TEST_F(NonEmptyGraph, saveAndMap){
+    graph.addNode(100);
+    size_t colorCount = graph.coloring(ColoringStrategy::DSatur);
+    std::string path = TempDir() + "tdd_graph_save.bin";
+    graph.save(path);
+
+    MappedGraph mapped(path);
+    EXPECT_EQ(mapped.nodeCount(), 6);
+    EXPECT_EQ(mapped.edgeCount(), 6);
+    EXPECT_EQ(mapped.graphDegree(), 3);
+
+    for (auto edge : graph.edges()){
+        EXPECT_TRUE(mapped.containsEdge(edge));
+        EXPECT_TRUE(mapped.containsEdge(Edge(edge.b, edge.a)));
+    }
+    EXPECT_FALSE(mapped.containsEdge(Edge(1, 7)));
+    EXPECT_FALSE(mapped.containsEdge(Edge(1, 9)));
+
+    EXPECT_EQ(mapped.nodeDegree(5), 3);
+    EXPECT_EQ(mapped.nodeDegree(100), 0);
+    EXPECT_THROW(mapped.nodeDegree(9), std::out_of_range);
+
+    std::vector<size_t> neighbors;
+    for (auto index : mapped.neighbors(6)){
+        neighbors.push_back(mapped.nodeIdAt(index));
+    }
+    EXPECT_THAT(neighbors, ElementsAre(4, 5, 7));
+
+    ASSERT_TRUE(mapped.hasColors());
+    for (auto node : graph.nodes()){
+        EXPECT_EQ(mapped.color(node->id), node->color);
+        EXPECT_LE(mapped.color(node->id), colorCount);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(MappedGraph, invalidFile){
+    std::string path = TempDir() + "tdd_graph_invalid.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "definitely not a graph file, but long enough for a header";
+    }
+    EXPECT_THROW(MappedGraph mapped(path), std::runtime_error);
+    EXPECT_THROW(MappedGraph mapped(path + ".missing"), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST_F(NonEmptyGraph, verifyMappedGraph){
+    std::string path = TempDir() + "tdd_graph_corrupted.bin";
+    graph.save(path);
+    EXPECT_NO_THROW(MappedGraph mapped(path, true));
+
+    // the first neighbor index follows the header, nodeCount ids and nodeCount + 1 offsets
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(GraphFileHeader) + (2 * graph.nodeCount() + 1) * sizeof(uint64_t));
+        uint64_t corrupted = 1000;
+        file.write(reinterpret_cast<const char*>(&corrupted), sizeof(corrupted));
+    }
+    EXPECT_NO_THROW(MappedGraph mapped(path));
+    EXPECT_THROW(MappedGraph mapped(path, true), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST_F(EmptyGraph, importEdgeList){
+    std::string path = TempDir() + "tdd_edge_list.txt";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "# SNAP style comment\n\n1\t4\n  1 5 0.5\r\n4 6\n6 4\n5 5\n% other comment\n5 6\n5 7\n7 6";
+    }
+
+    for (size_t chunkSize : {7, 64, 1 << 20}){
+        for (size_t threads : {1, 3}){
+            graph.clear();
+            EXPECT_EQ(graph.importEdgeList(path, chunkSize, threads), 6);
+            EXPECT_THAT(graph.edges(), UnorderedElementsAre(Eq(Edge(1, 4)), Eq(Edge(1, 5)), Eq(Edge(4, 6)),
+                                                            Eq(Edge(5, 6)), Eq(Edge(5, 7)), Eq(Edge(7, 6))));
+            EXPECT_EQ(graph.nodeCount(), 5);
+        }
+    }
+    EXPECT_EQ(graph.importEdgeList(path), 0);
+    std::remove(path.c_str());
+}
+
+TEST_F(EmptyGraph, importMatrixMarket){
+    std::string path = TempDir() + "tdd_edge_list.mtx";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "%%MatrixMarket matrix coordinate pattern symmetric\n% comment\n8 8 3\n2 1\n3 1\n8 2\n";
+    }
+    EXPECT_EQ(graph.importEdgeList(path, 64, 2), 3);
+    EXPECT_FALSE(graph.containsEdge(Edge(8, 3)));
+    EXPECT_TRUE(graph.containsEdge(Edge(2, 8)));
+    std::remove(path.c_str());
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "1 2\n3 x\n";
+    }
+    EXPECT_THROW(graph.importEdgeList(path), std::runtime_error);
+    for (auto line : {"3 4x\n", "3 4.5\n", "1 2e3\n", "1x 2\n", "1 2,3\n"}){
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "1 2\n" << line << "5 6 0.5\n";
+        }
+        EXPECT_THROW(graph.importEdgeList(path), std::runtime_error) << line;
+    }
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "18446744073709551615 1\n18446744073709551616 2\n";
+    }
+    EXPECT_THROW(graph.importEdgeList(path), std::runtime_error);
+    graph.clear();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "18446744073709551615 1\n";
+    }
+    EXPECT_EQ(graph.importEdgeList(path), 1);
+    EXPECT_TRUE(graph.containsEdge(Edge(SIZE_MAX, 1)));
+    EXPECT_THROW(graph.importEdgeList(path + ".missing"), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST_F(NonEmptyGraph, bfs){
+    graph.addMultipleEdges({{8, 9}});
+    std::vector<size_t> distances(graph.nodeCount());
+    std::vector<size_t> parents(graph.nodeCount());
+
+    EXPECT_EQ(graph.bfs(1, distances.data(), parents.data()), 5);
+    EXPECT_EQ(distances[graph.indexOf(1)], 0);
+    EXPECT_EQ(distances[graph.indexOf(4)], 1);
+    EXPECT_EQ(distances[graph.indexOf(5)], 1);
+    EXPECT_EQ(distances[graph.indexOf(6)], 2);
+    EXPECT_EQ(distances[graph.indexOf(7)], 2);
+    EXPECT_EQ(distances[graph.indexOf(8)], Graph::UNREACHED);
+    EXPECT_EQ(parents[graph.indexOf(1)], graph.indexOf(1));
+    EXPECT_EQ(parents[graph.indexOf(7)], graph.indexOf(5));
+    EXPECT_EQ(parents[graph.indexOf(9)], Graph::UNREACHED);
+
+    EXPECT_EQ(graph.bfs({7, 8}, distances.data()), 7);
+    EXPECT_EQ(distances[graph.indexOf(1)], 2);
+    EXPECT_EQ(distances[graph.indexOf(9)], 1);
+
+    EXPECT_THROW(graph.bfs(10, distances.data()), std::out_of_range);
+}
+
+TEST_F(EmptyGraph, bfsMatchesAcrossDirectionsAndThreads){
+    // dense random graph, the middle levels switch to the bottom-up step
+    size_t state = 5;
+    for (size_t i = 0; i < 20000; i++){
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        graph.addEdge(Edge((state >> 33) % 2000, (state >> 13) % 2000));
+    }
+    for (size_t id = 2000; id < 2100; id++){
+        graph.addEdge(Edge(id, id + 1));
+    }
+
+    // reference distances from a plain queue based search
+    size_t count = graph.nodeCount();
+    std::vector<size_t> expected(count, Graph::UNREACHED);
+    std::vector<size_t> queue{graph.indexOf(0)};
+    expected[queue[0]] = 0;
+    for (size_t i = 0; i < queue.size(); i++){
+        for (auto neighborId : graph.neighbors(graph.nodesView()[queue[i]]->id)){
+            size_t neighbor = graph.indexOf(neighborId);
+            if (expected[neighbor] == Graph::UNREACHED){
+                expected[neighbor] = expected[queue[i]] + 1;
+                queue.push_back(neighbor);
+            }
+        }
+    }
+
+    for (size_t threads : {1, 4}){
+        std::vector<size_t> distances(count);
+        std::vector<size_t> parents(count);
+        EXPECT_EQ(graph.bfs(0, distances.data(), parents.data(), threads), queue.size());
+        EXPECT_EQ(distances, expected);
+        for (size_t i = 0; i < count; i++){
+            if (expected[i] != Graph::UNREACHED && expected[i] != 0){
+                EXPECT_EQ(distances[parents[i]] + 1, distances[i]);
+                EXPECT_TRUE(graph.containsEdge(Edge(graph.nodesView()[i]->id, graph.nodesView()[parents[i]]->id)));
+            }
+        }
+    }
+}
+
+TEST_F(NonEmptyGraph, dfs){
+    graph.addNode(9);
+    std::vector<size_t> order(graph.nodeCount());
+    EXPECT_EQ(graph.dfs(4, order.data()), 5);
+    EXPECT_EQ(order[0], graph.indexOf(4));
+
+    std::vector<size_t> ids;
+    for (size_t i = 0; i < 5; i++){
+        ids.push_back(graph.nodesView()[order[i]]->id);
+    }
+    EXPECT_THAT(ids, UnorderedElementsAre(1, 4, 5, 6, 7));
+    EXPECT_EQ(graph.dfs(9, order.data()), 1);
+    EXPECT_THROW(graph.dfs(10, order.data()), std::out_of_range);
+}
+
+TEST_F(NonEmptyGraph, connectedComponents){
+    graph.addMultipleEdges({{8, 9}, {9, 10}});
+    graph.addNode(11);
+
+    auto components = graph.connectedComponents();
+    ASSERT_EQ(components.labels.size(), graph.nodeCount());
+    EXPECT_THAT(components.sizes, UnorderedElementsAre(5, 3, 1));
+    EXPECT_EQ(components.labels[graph.indexOf(1)], components.labels[graph.indexOf(7)]);
+    EXPECT_EQ(components.labels[graph.indexOf(8)], components.labels[graph.indexOf(10)]);
+    EXPECT_NE(components.labels[graph.indexOf(1)], components.labels[graph.indexOf(8)]);
+    EXPECT_NE(components.labels[graph.indexOf(11)], components.labels[graph.indexOf(8)]);
+}
+
+TEST_F(EmptyGraph, connectedComponentsParallel){
+    size_t state = 31;
+    for (size_t i = 0; i < 3000; i++){
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        graph.addEdge(Edge((state >> 33) % 5000, (state >> 13) % 5000));
+    }
+    EXPECT_EQ(graph.connectedComponents(0).labels.size(), graph.nodeCount());
+
+    auto expected = graph.connectedComponents(1);
+    auto components = graph.connectedComponents(4);
+    EXPECT_EQ(components.labels, expected.labels);
+    EXPECT_EQ(components.sizes, expected.sizes);
+
+    // every component matches the nodes reached by a search from its first node
+    std::vector<size_t> distances(graph.nodeCount());
+    for (size_t slot = 0; slot < graph.nodeCount(); slot += 97){
+        size_t reached = graph.bfs(graph.nodesView()[slot]->id, distances.data());
+        EXPECT_EQ(reached, components.sizes[components.labels[slot]]);
+        for (size_t other = 0; other < graph.nodeCount(); other++){
+            EXPECT_EQ(distances[other] != Graph::UNREACHED, components.labels[other] == components.labels[slot]);
+        }
+    }
+}
+
+TEST_F(EmptyGraph, connectedComponents){
+    auto components = graph.connectedComponents(4);
+    EXPECT_TRUE(components.labels.empty());
+    EXPECT_TRUE(components.sizes.empty());
+}
+
+TEST_F(NonEmptyGraph, freeze){
+    FrozenGraph frozen = graph.freeze();
+    graph.removeNode(5);
+    graph.addEdge(Edge(1, 7));
+
+    EXPECT_EQ(frozen.nodeCount(), 5);
+    EXPECT_EQ(frozen.edgeCount(), 6);
+    EXPECT_EQ(frozen.graphDegree(), 3);
+    EXPECT_TRUE(frozen.containsEdge(Edge(5, 1)));
+    EXPECT_FALSE(frozen.containsEdge(Edge(1, 7)));
+    EXPECT_EQ(frozen.indexOf(9), NodeIndex::npos);
+    EXPECT_THROW(frozen.neighbors(9), std::out_of_range);
+
+    std::vector<size_t> colors(frozen.nodeCount());
+    size_t colorCount = frozen.coloring(colors.data());
+    EXPECT_LE(colorCount, frozen.graphDegree() + 1);
+    for (size_t i = 0; i < frozen.nodeCount(); i++){
+        EXPECT_GE(colors[i], 1);
+        EXPECT_LE(colors[i], colorCount);
+        for (auto neighbor : frozen.neighborsAt(i)){
+            EXPECT_NE(colors[i], colors[neighbor]);
+        }
+    }
+
+    std::vector<size_t> degreeSums(4, 0);
+    parallelFor(degreeSums.size(), degreeSums.size(), [&](size_t begin, size_t end, size_t){
+        for (size_t t = begin; t < end; t++){
+            for (auto id : {1, 4, 5, 6, 7}){
+                degreeSums[t] += frozen.nodeDegree(id);
+            }
+        }
+    });
+    EXPECT_THAT(degreeSums, Each(Eq(12)));
+}
+
+TEST(ConcurrentGraph, singleThread){
+    ConcurrentGraph graph(5);
+    EXPECT_EQ(graph.shardCount(), 8);
+    EXPECT_TRUE(graph.addEdge(Edge(1, 2)));
+    EXPECT_FALSE(graph.addEdge(Edge(2, 1)));
+    EXPECT_FALSE(graph.addEdge(Edge(3, 3)));
+    EXPECT_TRUE(graph.addEdge(Edge(2, 3)));
+    EXPECT_FALSE(graph.addNode(3));
+    EXPECT_TRUE(graph.addNode(4));
+
+    EXPECT_EQ(graph.nodeCount(), 4);
+    EXPECT_EQ(graph.edgeCount(), 2);
+    EXPECT_TRUE(graph.containsEdge(Edge(3, 2)));
+    EXPECT_FALSE(graph.containsEdge(Edge(1, 3)));
+    EXPECT_EQ(graph.nodeDegree(2), 2);
+    EXPECT_THAT(graph.neighbors(2), UnorderedElementsAre(1, 3));
+    EXPECT_THAT(graph.edges(), UnorderedElementsAre(Eq(Edge(1, 2)), Eq(Edge(2, 3))));
+
+    graph.removeEdge(Edge(2, 1));
+    EXPECT_THROW(graph.removeEdge(Edge(1, 2)), std::out_of_range);
+    graph.removeNode(2);
+    EXPECT_FALSE(graph.containsNode(2));
+    EXPECT_EQ(graph.nodeDegree(3), 0);
+    EXPECT_EQ(graph.edgeCount(), 0);
+    EXPECT_EQ(graph.nodeCount(), 3);
+    EXPECT_THROW(graph.nodeDegree(2), std::out_of_range);
+    EXPECT_THROW(graph.removeNode(2), std::out_of_range);
+}
+
+TEST(ConcurrentGraph, parallelWriters){
+    ConcurrentGraph graph(4);
+    const size_t nodes = 200;
+
+    // every thread adds all edges of a complete graph, later removes its share of them
+    parallelFor(4, 4, [&](size_t, size_t, size_t thread){
+        for (size_t a = 0; a < nodes; a++){
+            for (size_t b = a + 1; b < nodes; b++){
+                graph.addEdge(thread % 2 ? Edge(a, b) : Edge(b, a));
+                EXPECT_TRUE(graph.containsEdge(Edge(b, a)));
+            }
+        }
+    });
+    EXPECT_EQ(graph.edgeCount(), nodes * (nodes - 1) / 2);
+    EXPECT_EQ(graph.nodeCount(), nodes);
+
+    parallelFor(nodes, 4, [&](size_t begin, size_t end, size_t){
+        for (size_t a = begin; a < end; a++){
+            for (size_t b = a + 1; b < nodes; b++){
+                if ((a + b) % 2 == 0){
+                    graph.removeEdge(Edge(a, b));
+                }
+            }
+        }
+    });
+    for (size_t a = 0; a < nodes; a++){
+        EXPECT_EQ(graph.nodeDegree(a), nodes / 2);
+    }
+    EXPECT_EQ(graph.edges().size(), graph.edgeCount());
+}
+
+TEST_F(NonEmptyGraph, removeNodeKeepsIndicesDense){
+    graph.removeNode(1);
+    graph.removeNode(6);
+    ASSERT_EQ(graph.nodeCount(), 3);
+
+    // every node keeps the neighbors it had, whatever index it moved to
+    for (size_t index = 0; index < graph.nodeCount(); index++){
+        size_t nodeId = graph.nodeIdAt(index);
+        EXPECT_EQ(graph.indexOf(nodeId), index);
+        std::vector<size_t> neighbors;
+        for (auto neighbor : graph.neighborsAt(index)){
+            ASSERT_LT(neighbor, graph.nodeCount());
+            neighbors.push_back(graph.nodeIdAt(neighbor));
+        }
+        EXPECT_THAT(neighbors, UnorderedElementsAreArray(std::vector<size_t>(graph.neighbors(nodeId).begin(),
+                                                                             graph.neighbors(nodeId).end())));
+    }
+    EXPECT_THAT(graph.neighbors(5), ElementsAre(7));
+    EXPECT_THAT(graph.neighbors(4), IsEmpty());
+}
+
+TEST_F(NonEmptyGraph, reorder){
+    graph.coloring(ColoringStrategy::DSatur);
+    std::vector<size_t> colors;
+    for (auto id : {1, 4, 5, 6, 7}){
+        colors.push_back(graph.getNode(id)->color);
+    }
+
+    for (auto strategy : {ReorderStrategy::ReverseCuthillMcKee, ReorderStrategy::DegreeDescending,
+                          ReorderStrategy::HubClustering}){
+        double gap = graph.averageGap();
+        ReorderStats stats = graph.reorder(strategy);
+        EXPECT_DOUBLE_EQ(stats.gapBefore, gap);
+        EXPECT_DOUBLE_EQ(stats.gapAfter, graph.averageGap());
+
+        EXPECT_EQ(graph.edgeCount(), 6);
+        EXPECT_THAT(graph.neighbors(6), UnorderedElementsAre(4, 5, 7));
+        EXPECT_THAT(graph.neighbors(1), UnorderedElementsAre(4, 5));
+        size_t i = 0;
+        for (auto id : {1, 4, 5, 6, 7}){
+            EXPECT_EQ(graph.nodeIdAt(graph.indexOf(id)), id);
+            EXPECT_EQ(graph.getNode(id)->color, colors[i++]);
+        }
+    }
+    EXPECT_EQ(graph.nodeIdAt(1), 5);
+    EXPECT_EQ(graph.nodeIdAt(0), 6);
+}
+
+TEST_F(EmptyGraph, reorderGrid){
+    // a 20x20 grid added row by row but with scattered ids, so insertion order is far from the layout
+    const size_t side = 20;
+    std::vector<Edge> edges;
+    for (size_t i = 0; i < side * side; i++){
+        size_t id = (i * 7919) % (side * side);
+        if (i % side + 1 < side){
+            edges.emplace_back(id, ((i + 1) * 7919) % (side * side));
+        }
+        if (i + side < side * side){
+            edges.emplace_back(id, ((i + side) * 7919) % (side * side));
+        }
+    }
+    for (size_t i = 0; i < side * side; i++){
+        graph.addNode(i);
+    }
+    graph.addMultipleEdges(edges);
+
+    ReorderStats stats = graph.reorder(ReorderStrategy::ReverseCuthillMcKee);
+    EXPECT_GT(stats.gapBefore, 4 * stats.gapAfter);
+    EXPECT_LT(stats.gapAfter, side);
+    EXPECT_EQ(graph.edgeCount(), edges.size());
+    for (auto& edge : edges){
+        ASSERT_TRUE(graph.containsEdge(edge));
+    }
+    EXPECT_LE(graph.coloring(ColoringStrategy::SmallestLast), 3);
+}
+
+TEST(IntersectKernel, sameResults){
+    std::vector<uint32_t> a;
+    std::vector<uint32_t> b;
+    for (uint32_t i = 0; i < 200; i++){
+        if (i % 3 == 0){
+            a.push_back(i);
+        }
+        if (i % 5 != 1){
+            b.push_back(i);
+        }
+    }
+    size_t expected = 0;
+    for (auto value : a){
+        expected += std::binary_search(b.begin(), b.end(), value);
+    }
+
+    for (auto kernel : {IntersectKernel::Scalar, IntersectKernel::Sse2, IntersectKernel::Avx2, IntersectKernel::Best}){
+        for (size_t sizeA : {size_t(0), size_t(5), size_t(17), a.size()}){
+            size_t prefix = std::count_if(a.begin(), a.begin() + sizeA, [&b](uint32_t value){
+                return std::binary_search(b.begin(), b.end(), value);
+            });
+            EXPECT_EQ(intersectSortedCount(a.data(), sizeA, b.data(), b.size(), kernel), prefix);
+            EXPECT_EQ(intersectSortedCount(b.data(), b.size(), a.data(), sizeA, kernel), prefix);
+        }
+        EXPECT_EQ(intersectSortedCount(a.data(), a.size(), b.data(), b.size(), kernel), expected);
+    }
+    EXPECT_TRUE(intersectKernelAvailable(IntersectKernel::Scalar));
+}
+
+TEST_F(NonEmptyGraph, triangles){
+    EXPECT_EQ(graph.triangleCount(), 1);
+    std::vector<size_t> triangles = graph.nodeTriangles();
+    EXPECT_EQ(triangles[graph.indexOf(5)], 1);
+    EXPECT_EQ(triangles[graph.indexOf(1)], 0);
+
+    std::vector<double> coefficients = graph.clusteringCoefficients();
+    EXPECT_DOUBLE_EQ(coefficients[graph.indexOf(7)], 1);
+    EXPECT_DOUBLE_EQ(coefficients[graph.indexOf(6)], 1.0 / 3);
+    EXPECT_DOUBLE_EQ(coefficients[graph.indexOf(1)], 0);
+
+    // a complete graph on 20 nodes has C(20, 3) triangles, every node is in C(19, 2) of them
+    graph.clear();
+    for (size_t a = 0; a < 20; a++){
+        for (size_t b = a + 1; b < 20; b++){
+            graph.addEdge(Edge(a, b));
+        }
+    }
+    for (auto kernel : {IntersectKernel::Scalar, IntersectKernel::Sse2, IntersectKernel::Avx2}){
+        for (size_t threads : {1, 3}){
+            EXPECT_EQ(graph.triangleCount(threads, kernel), 1140);
+            EXPECT_THAT(graph.nodeTriangles(threads, kernel), Each(Eq(171)));
+        }
+    }
+    EXPECT_THAT(graph.clusteringCoefficients(2), Each(DoubleEq(1)));
+}
+
+TEST_F(NonEmptyGraph, compress){
+    graph.addEdge(Edge(1000000, 1));
+    FrozenGraph frozen = graph.freeze();
+    CompressedGraph compressed(graph);
+
+    EXPECT_EQ(compressed.nodeCount(), 6);
+    EXPECT_EQ(compressed.edgeCount(), 7);
+    EXPECT_EQ(compressed.graphDegree(), 3);
+    for (size_t index = 0; index < frozen.nodeCount(); index++){
+        EXPECT_EQ(compressed.nodeIdAt(index), frozen.nodeIdAt(index));
+        EXPECT_EQ(compressed.degreeAt(index), frozen.neighborsAt(index).size());
+        std::vector<size_t> neighbors;
+        compressed.forEachNeighbor(index, [&neighbors](size_t neighbor){
+            neighbors.push_back(neighbor);
+        });
+        Span<uint64_t> expected = frozen.neighborsAt(index);
+        EXPECT_THAT(neighbors, ElementsAreArray(expected.begin(), expected.end()));
+    }
+
+    for (auto edge : graph.edges()){
+        EXPECT_TRUE(compressed.containsEdge(edge));
+        EXPECT_TRUE(compressed.containsEdge(Edge(edge.b, edge.a)));
+    }
+    EXPECT_FALSE(compressed.containsEdge(Edge(4, 5)));
+    EXPECT_FALSE(compressed.containsEdge(Edge(1, 9)));
+    EXPECT_EQ(compressed.nodeDegree(1000000), 1);
+    EXPECT_THROW(compressed.nodeDegree(9), std::out_of_range);
+
+    std::vector<size_t> colors(compressed.nodeCount());
+    std::vector<size_t> frozenColors(frozen.nodeCount());
+    EXPECT_EQ(compressed.coloring(colors.data()), frozen.coloring(frozenColors.data()));
+    EXPECT_EQ(colors, frozenColors);
+}
+
+TEST(CompressedGraph, varint){
+    std::vector<uint8_t> bytes{0x05, 0xAC, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+    const uint8_t* position = bytes.data();
+    EXPECT_EQ(CompressedGraph::decodeVarint(position), 5);
+    EXPECT_EQ(CompressedGraph::decodeVarint(position), 300);
+    EXPECT_EQ(CompressedGraph::decodeVarint(position), UINT64_MAX);
+    EXPECT_EQ(position, bytes.data() + bytes.size());
+}
+
+// Mycielski construction, the chromatic number grows by one while the graph stays triangle free
+static void addMycielskian(Graph& graph, size_t levels){
+    graph.addEdge(Edge(0, 1));
+    for (size_t level = 0; level < levels; level++){
+        size_t count = graph.nodeCount();
+        for (auto edge : graph.edges()){
+            graph.addEdge(Edge(edge.a + count, edge.b));
+            graph.addEdge(Edge(edge.b + count, edge.a));
+        }
+        for (size_t i = 0; i < count; i++){
+            graph.addEdge(Edge(i + count, 2 * count));
+        }
+    }
+}
+
+TEST_F(NonEmptyGraph, optimalColoring){
+    ExactColoring result = graph.optimalColoring();
+    EXPECT_TRUE(result.optimal);
+    EXPECT_EQ(result.colorCount, 3);
+    EXPECT_EQ(result.lowerBound, 3);
+    expectValidColoring(graph, result.colorCount);
+}
+
+TEST_F(EmptyGraph, chromaticNumber){
+    EXPECT_EQ(graph.chromaticNumber(), 0);
+
+    // the Grötzsch graph has no triangle, so the clique bound is 2 and the search must prove 4
+    addMycielskian(graph, 2);
+    ASSERT_EQ(graph.nodeCount(), 11);
+    for (size_t threads : {1, 3}){
+        EXPECT_EQ(graph.chromaticNumber(threads), 4);
+        expectValidColoring(graph, 4);
+    }
+
+    graph.clear();
+    for (size_t i = 0; i < 7; i++){
+        graph.addEdge(Edge(i, (i + 1) % 7));
+    }
+    EXPECT_EQ(graph.chromaticNumber(2), 3);
+}
+
+TEST_F(EmptyGraph, optimalColoringTimeBudget){
+    addMycielskian(graph, 4);
+    ExactColoring result = graph.optimalColoring(0.05, 2);
+    EXPECT_FALSE(result.optimal);
+    EXPECT_EQ(result.lowerBound, 2);
+    EXPECT_GE(result.colorCount, 6);
+    expectValidColoring(graph, result.colorCount);
+}
+
+TEST_F(NonEmptyGraph, colorScheduler){
+    ColorScheduler scheduler(3);
+    EXPECT_EQ(scheduler.threadCount(), 3);
+    EXPECT_THROW(scheduler.run(graph, [](size_t){}), std::runtime_error);
+
+    size_t colorCount = graph.coloring(ColoringStrategy::DSatur);
+    std::vector<std::atomic<size_t>> runs(8);
+    std::vector<size_t> order(graph.nodeCount());
+    std::atomic<size_t> finished{0};
+    ScheduleStats stats = scheduler.run(graph, [&](size_t nodeId){
+        runs[nodeId]++;
+        order[finished++] = graph.nodesView()[graph.indexOf(nodeId)]->color;
+    });
+
+    for (auto id : {1, 4, 5, 6, 7}){
+        EXPECT_EQ(runs[id].load(), 1);
+    }
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+    ASSERT_EQ(stats.classes.size(), colorCount);
+    size_t tasks = 0;
+    for (size_t i = 0; i < stats.classes.size(); i++){
+        EXPECT_EQ(stats.classes[i].color, i + 1);
+        EXPECT_LE(stats.classes[i].steals, stats.classes[i].taskCount);
+        tasks += stats.classes[i].taskCount;
+    }
+    EXPECT_EQ(tasks, graph.nodeCount());
+
+    graph.getNode(1)->color = graph.getNode(4)->color;
+    EXPECT_THROW(scheduler.run(graph, [](size_t){}), std::runtime_error);
+}
+
+TEST_F(EmptyGraph, colorSchedulerTaskFailure){
+    for (size_t id = 0; id < 100; id++){
+        graph.addEdge(Edge(id, id + 1));
+    }
+    graph.coloring();
+    ColorScheduler scheduler(4);
+    std::atomic<size_t> runs{0};
+    EXPECT_THROW(scheduler.run(graph, [&runs](size_t nodeId){
+        runs++;
+        if (nodeId == 10){
+            throw std::logic_error("task failed");
+        }
+    }), std::logic_error);
+    EXPECT_EQ(runs.load(), 51);
+
+    // the pool stays usable after a failed run
+    runs = 0;
+    scheduler.run(graph, [&runs](size_t){ runs++; });
+    EXPECT_EQ(runs.load(), 101);
+}
+
+// deletes the log and checkpoint files a test left next to the given base path
+static void removeGraphLog(const std::string& base){
+    std::remove((base + ".log").c_str());
+    std::remove((base + ".checkpoint").c_str());
+}
+
+TEST(GraphLog, replayAfterReopen){
+    std::string base = TempDir() + "tdd_graph_log_replay";
+    removeGraphLog(base);
+    {
+        Graph graph;
+        GraphLog log(base, graph, 4);
+        log.addNode(7);
+        log.addMultipleEdges({{1, 2}, {2, 3}, {3, 1}, {3, 4}});
+        log.removeEdge(Edge(1, 2));
+        log.addEdge(Edge(4, 5));
+        log.removeNode(3);
+        EXPECT_EQ(log.recordsSinceCheckpoint(), 8);
+    }
+
+    Graph graph;
+    GraphLog log(base, graph);
+    EXPECT_EQ(log.replayedRecords(), 8);
+    EXPECT_EQ(graph.nodeCount(), 5);
+    EXPECT_EQ(graph.edgeCount(), 1);
+    EXPECT_TRUE(graph.containsEdge(Edge(4, 5)));
+    EXPECT_FALSE(graph.containsEdge(Edge(1, 2)));
+    EXPECT_EQ(graph.getNode(3), nullptr);
+    EXPECT_NE(graph.getNode(7), nullptr);
+    removeGraphLog(base);
+}
+
+TEST(GraphLog, logsOnlyAddedEdges){
+    std::string base = TempDir() + "tdd_graph_log_added";
+    removeGraphLog(base);
+    {
+        Graph graph;
+        GraphLog log(base, graph);
+        log.addEdge(Edge(1, 2));
+        log.addMultipleEdges({{2, 1}, {2, 3}, {3, 2}, {3, 3}, {2, 3}, {3, 4}});
+        log.addEdge(Edge(4, 3));
+        EXPECT_EQ(log.recordsSinceCheckpoint(), 3);
+        EXPECT_EQ(graph.edgeCount(), 3);
+    }
+
+    Graph graph;
+    GraphLog log(base, graph);
+    EXPECT_EQ(log.replayedRecords(), 3);
+    EXPECT_EQ(graph.edgeCount(), 3);
+    removeGraphLog(base);
+}
+
+TEST(GraphLog, groupCommit){
+    std::string base = TempDir() + "tdd_graph_log_group";
+    removeGraphLog(base);
+    Graph graph;
+    GraphLog log(base, graph, 10);
+    for (size_t i = 0; i < 25; i++){
+        log.addEdge(Edge(i, i + 1));
+    }
+    EXPECT_EQ(log.syncCount(), 2);
+    EXPECT_EQ(log.pendingRecords(), 5);
+    log.commit();
+    EXPECT_EQ(log.syncCount(), 3);
+    EXPECT_EQ(log.pendingRecords(), 0);
+    removeGraphLog(base);
+}
+
+TEST(GraphLog, checkpointLimitsReplay){
+    std::string base = TempDir() + "tdd_graph_log_checkpoint";
+    removeGraphLog(base);
+    {
+        Graph graph;
+        GraphLog log(base, graph, 8, 100);
+        for (size_t i = 0; i < 130; i++){
+            log.addEdge(Edge(i, i + 1));
+        }
+        log.addNode(1000);
+        log.clear();
+        log.addEdge(Edge(1, 2));
+        log.addEdge(Edge(2, 3));
+        EXPECT_EQ(log.recordsSinceCheckpoint(), 34);
+        log.checkpoint();
+        log.removeEdge(Edge(1, 2));
+        EXPECT_EQ(log.recordsSinceCheckpoint(), 1);
+    }
+
+    Graph graph;
+    GraphLog log(base, graph);
+    EXPECT_EQ(log.replayedRecords(), 1);
+    EXPECT_EQ(graph.nodeCount(), 3);
+    EXPECT_EQ(graph.edgeCount(), 1);
+    EXPECT_TRUE(graph.containsEdge(Edge(2, 3)));
+    removeGraphLog(base);
+}
+
+TEST(GraphLog, checkpointKeepsColorsAndIsolatedNodes){
+    std::string base = TempDir() + "tdd_graph_log_colors";
+    removeGraphLog(base);
+    {
+        Graph graph;
+        GraphLog log(base, graph);
+        log.addMultipleEdges({{1, 2}, {2, 3}, {3, 1}});
+        log.addNode(9);
+        graph.coloring();
+        log.checkpoint();
+    }
+
+    Graph graph;
+    GraphLog log(base, graph);
+    EXPECT_EQ(graph.nodeCount(), 4);
+    EXPECT_NE(graph.getNode(9), nullptr);
+    EXPECT_EQ(graph.edgeCount(), 3);
+    EXPECT_NE(graph.getNode(1)->color, graph.getNode(2)->color);
+    EXPECT_NE(graph.getNode(2)->color, graph.getNode(3)->color);
+    EXPECT_NE(graph.getNode(1)->color, 0);
+    removeGraphLog(base);
+}
+
+TEST(GraphLog, tornRecordIsDropped){
+    std::string base = TempDir() + "tdd_graph_log_torn";
+    removeGraphLog(base);
+    {
+        Graph graph;
+        GraphLog log(base, graph);
+        log.addEdge(Edge(1, 2));
+        log.addEdge(Edge(2, 3));
+    }
+    {
+        std::ofstream file(base + ".log", std::ios::binary | std::ios::app);
+        file << "torn";
+    }
+    {
+        Graph graph;
+        GraphLog log(base, graph);
+        EXPECT_EQ(log.replayedRecords(), 2);
+        log.addEdge(Edge(3, 4));
+    }
+
+    Graph graph;
+    GraphLog log(base, graph);
+    EXPECT_EQ(log.replayedRecords(), 3);
+    EXPECT_EQ(graph.edgeCount(), 3);
+    removeGraphLog(base);
+}
+
+TEST(GraphGenerators, deterministic){
+    for (auto generator : {GraphGenerator::ErdosRenyi, GraphGenerator::RMat, GraphGenerator::BarabasiAlbert,
+                           GraphGenerator::Grid}){
+        auto edges = generateEdges(generator, 500, 6, 7);
+        auto again = generateEdges(generator, 500, 6, 7);
+        ASSERT_EQ(edges.size(), again.size());
+        EXPECT_FALSE(edges.empty());
+        for (size_t i = 0; i < edges.size(); i++){
+            EXPECT_EQ(edges[i], again[i]);
+            EXPECT_NE(edges[i].a, edges[i].b);
+            EXPECT_LT(edges[i].a, 500);
+            EXPECT_LT(edges[i].b, 500);
+        }
+    }
+    EXPECT_NE(erdosRenyiEdges(500, 1000, 1), erdosRenyiEdges(500, 1000, 2));
+}
+
+TEST(GraphGenerators, grid){
+    Graph graph;
+    graph.addMultipleEdges(gridEdges(12));
+    EXPECT_EQ(graph.nodeCount(), 12);
+    EXPECT_EQ(graph.edgeCount(), 17);
+    EXPECT_EQ(graph.graphDegree(), 4);
+    EXPECT_TRUE(graph.containsEdge(Edge(0, 4)));
+    EXPECT_FALSE(graph.containsEdge(Edge(3, 4)));
+}
+
+TEST(GraphGenerators, barabasiAlbert){
+    Graph graph;
+    graph.addMultipleEdges(barabasiAlbertEdges(2000, 3, 5));
+    EXPECT_EQ(graph.nodeCount(), 2000);
+    EXPECT_EQ(graph.edgeCount(), 6 + 3 * (2000 - 4));
+    for (size_t node = 4; node < 2000; node++){
+        EXPECT_GE(graph.nodeDegree(node), 3);
+    }
+    EXPECT_GT(graph.graphDegree(), 30);
+}
+
+TEST_F(NonEmptyGraph, subgraphView){
+    SubgraphView view(graph, {5, 6, 7, 7});
+    EXPECT_EQ(view.nodeCount(), 3);
+    EXPECT_EQ(view.edgeCount(), 3);
+    EXPECT_EQ(view.graphDegree(), 2);
+    EXPECT_EQ(view.nodeDegree(5), 2);
+    EXPECT_TRUE(view.containsEdge(Edge(6, 5)));
+    EXPECT_FALSE(view.containsEdge(Edge(1, 5)));
+    EXPECT_FALSE(view.containsNode(1));
+    EXPECT_THROW(view.nodeDegree(1), std::out_of_range);
+    EXPECT_THROW(SubgraphView(graph, {5, 9}), std::out_of_range);
+
+    std::vector<size_t> neighbors;
+    view.forEachNeighbor(view.indexOf(5), [&](size_t index){ neighbors.push_back(view.nodeIdAt(index)); });
+    EXPECT_THAT(neighbors, UnorderedElementsAre(6, 7));
+
+    std::vector<size_t> colors(view.nodeCount());
+    EXPECT_EQ(view.coloring(colors.data()), 3);
+    EXPECT_THAT(colors, UnorderedElementsAre(1, 2, 3));
+}
+
+TEST_F(NonEmptyGraph, egoNetwork){
+    EXPECT_EQ(SubgraphView::egoNetwork(graph, 1, 0).nodeCount(), 1);
+
+    SubgraphView near = SubgraphView::egoNetwork(graph, 1, 1);
+    EXPECT_EQ(near.nodeCount(), 3);
+    EXPECT_EQ(near.edgeCount(), 2);
+    EXPECT_TRUE(near.containsNode(4));
+    EXPECT_FALSE(near.containsNode(6));
+
+    SubgraphView all = SubgraphView::egoNetwork(graph, 1, 2);
+    EXPECT_EQ(all.nodeCount(), 5);
+    EXPECT_EQ(all.edgeCount(), 6);
+    EXPECT_THROW(SubgraphView::egoNetwork(graph, 9, 1), std::out_of_range);
+}
+
+TEST_F(NonEmptyGraph, freezeSubgraph){
+    FrozenGraph frozen = SubgraphView(graph, {6, 1, 4, 5}).freeze();
+    graph.clear();
+
+    EXPECT_EQ(frozen.nodeCount(), 4);
+    EXPECT_EQ(frozen.edgeCount(), 4);
+    EXPECT_EQ(frozen.graphDegree(), 2);
+    for (size_t i = 0; i + 1 < frozen.nodeCount(); i++){
+        EXPECT_LT(frozen.nodeIdAt(i), frozen.nodeIdAt(i + 1));
+    }
+    EXPECT_TRUE(frozen.containsEdge(Edge(5, 1)));
+    EXPECT_TRUE(frozen.containsEdge(Edge(4, 6)));
+    EXPECT_FALSE(frozen.containsEdge(Edge(5, 7)));
+    EXPECT_EQ(frozen.indexOf(7), NodeIndex::npos);
+    EXPECT_EQ(frozen.nodeDegree(6), 2);
+}
+
+TEST(SubgraphView, egoNetworkInGrid){
+    Graph graph;
+    graph.addMultipleEdges(gridEdges(100));
+    SubgraphView view = SubgraphView::egoNetwork(graph, 55, 2);
+    EXPECT_EQ(view.nodeCount(), 13);
+    EXPECT_EQ(view.edgeCount(), 16);
+    EXPECT_EQ(view.graphDegree(), 4);
+    EXPECT_TRUE(view.containsNode(35));
+    EXPECT_FALSE(view.containsNode(34));
+
+    FrozenGraph frozen = view.freeze();
+    EXPECT_EQ(frozen.edgeCount(), 16);
+    for (size_t i = 0; i < frozen.nodeCount(); i++){
+        EXPECT_EQ(frozen.neighborsAt(i).size(), view.nodeDegree(frozen.nodeIdAt(i)));
+    }
+}
+
 /*** Konec souboru tdd_tests.cpp ***/
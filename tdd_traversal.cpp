@@ -0,0 +1,289 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_traversal.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_traversal.cpp
+ * @author David Bujzaš
+ *
+ * @brief Implementace prohledávání grafu.
+ */
+
+#include "tdd_code.h"
+
+#include <atomic>
+
+const size_t Graph::UNREACHED;
+
+namespace {
+
+// switching thresholds from Beamer et al., top-down while the frontier has few edges compared
+// to the unexplored part, bottom-up while the frontier holds a large share of the nodes
+const size_t TOP_DOWN_ALPHA = 14;
+const size_t BOTTOM_UP_BETA = 24;
+
+} // namespace
+
+size_t Graph::bfs(size_t sourceId, size_t* distances, size_t* parents, size_t threadCount) const {
+    return bfs(std::vector<size_t>{sourceId}, distances, parents, threadCount);
+}
+
+size_t Graph::bfs(const std::vector<size_t>& sourceIds, size_t* distances, size_t* parents,
+                  size_t threadCount) const {
+    size_t count = graphNodes.size();
+    size_t words = (count + 63) / 64;
+    threadCount = std::max<size_t>(threadCount, 1);
+
+    for (auto sourceId : sourceIds) {
+        if (slotOf(sourceId) == NodeIndex::npos) {
+            throw std::out_of_range("Node does not exist!\n");
+        }
+    }
+
+    std::fill(distances, distances + count, UNREACHED);
+    if (parents != nullptr) {
+        std::fill(parents, parents + count, UNREACHED);
+    }
+
+    // visited bits are claimed atomically in the top-down step, frontier bits are read-only during a step
+    std::vector<std::atomic<uint64_t>> visited(words);
+    for (auto& word : visited) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    std::vector<uint64_t> frontierBits(words, 0);
+    std::vector<uint64_t> nextBits(words, 0);
+
+    std::vector<size_t> frontier;
+    size_t frontierEdges = 0;
+    size_t reached = 0;
+    for (auto sourceId : sourceIds) {
+        size_t slot = slotOf(sourceId);
+        if (distances[slot] == 0) {
+            continue;
+        }
+        frontier.push_back(slot);
+        distances[slot] = 0;
+        if (parents != nullptr) {
+            parents[slot] = slot;
+        }
+        visited[slot / 64].fetch_or(uint64_t(1) << (slot % 64), std::memory_order_relaxed);
+        frontierEdges += adjacency[slot].size();
+        reached++;
+    }
+
+    size_t unexploredEdges = 2 * graphEdges.size();
+    size_t frontierSize = frontier.size();
+    bool bottomUp = false;
+    std::vector<std::vector<size_t>> nextParts(threadCount);
+    std::vector<size_t> partEdges(threadCount);
+    std::vector<size_t> partSizes(threadCount);
+
+    for (size_t level = 0; frontierSize != 0; level++) {
+        // chooses the direction and converts the frontier representation when it changes
+        if (!bottomUp && frontierEdges > unexploredEdges / TOP_DOWN_ALPHA) {
+            bottomUp = true;
+            std::fill(frontierBits.begin(), frontierBits.end(), 0);
+            for (auto slot : frontier) {
+                frontierBits[slot / 64] |= uint64_t(1) << (slot % 64);
+            }
+        } else if (bottomUp && frontierSize < count / BOTTOM_UP_BETA) {
+            bottomUp = false;
+            frontier.clear();
+            for (size_t w = 0; w < words; w++) {
+                for (uint64_t bits = frontierBits[w]; bits != 0; bits &= bits - 1) {
+                    frontier.push_back(w * 64 + countTrailingZeros(bits));
+                }
+            }
+        }
+        unexploredEdges -= std::min(unexploredEdges, frontierEdges);
+
+        if (bottomUp) {
+            // every unvisited node looks for a neighbor in the frontier, threads own whole bitmap words
+            parallelFor(words, threadCount, [&](size_t begin, size_t end, size_t thread) {
+                size_t edges = 0;
+                size_t size = 0;
+                for (size_t w = begin; w < end; w++) {
+                    uint64_t next = 0;
+                    uint64_t unvisited = ~visited[w].load(std::memory_order_relaxed);
+                    for (size_t bit = 0; bit < 64 && w * 64 + bit < count; bit++) {
+                        if ((unvisited >> bit & 1) == 0) {
+                            continue;
+                        }
+                        size_t slot = w * 64 + bit;
+                        for (auto neighbor : adjacency[slot]) {
+                            if (frontierBits[neighbor / 64] >> (neighbor % 64) & 1) {
+                                distances[slot] = level + 1;
+                                if (parents != nullptr) {
+                                    parents[slot] = neighbor;
+                                }
+                                next |= uint64_t(1) << bit;
+                                edges += adjacency[slot].size();
+                                size++;
+                                break;
+                            }
+                        }
+                    }
+                    nextBits[w] = next;
+                    visited[w].fetch_or(next, std::memory_order_relaxed);
+                }
+                partEdges[thread] = edges;
+                partSizes[thread] = size;
+            });
+            frontierBits.swap(nextBits);
+        } else {
+            // every frontier node claims its unvisited neighbors
+            parallelFor(frontier.size(), threadCount, [&](size_t begin, size_t end, size_t thread) {
+                auto& next = nextParts[thread];
+                next.clear();
+                size_t edges = 0;
+                for (size_t i = begin; i < end; i++) {
+                    size_t slot = frontier[i];
+                    for (auto neighbor : adjacency[slot]) {
+                        uint64_t bit = uint64_t(1) << (neighbor % 64);
+                        if ((visited[neighbor / 64].load(std::memory_order_relaxed) & bit) != 0
+                            || (visited[neighbor / 64].fetch_or(bit, std::memory_order_relaxed) & bit) != 0) {
+                            continue;
+                        }
+                        distances[neighbor] = level + 1;
+                        if (parents != nullptr) {
+                            parents[neighbor] = slot;
+                        }
+                        next.push_back(neighbor);
+                        edges += adjacency[neighbor].size();
+                    }
+                }
+                partEdges[thread] = edges;
+                partSizes[thread] = next.size();
+            });
+            frontier.clear();
+            for (auto& part : nextParts) {
+                frontier.insert(frontier.end(), part.begin(), part.end());
+            }
+        }
+
+        frontierEdges = 0;
+        frontierSize = 0;
+        for (size_t t = 0; t < threadCount; t++) {
+            frontierEdges += partEdges[t];
+            frontierSize += partSizes[t];
+            partEdges[t] = 0;
+            partSizes[t] = 0;
+        }
+        reached += frontierSize;
+    }
+
+    return reached;
+}
+
+// iterative depth-first search, the stack keeps the position in the adjacency list of every open node
+size_t Graph::dfs(size_t sourceId, size_t* order) const {
+    size_t source = slotOf(sourceId);
+    if (source == NodeIndex::npos) {
+        throw std::out_of_range("Node does not exist!\n");
+    }
+
+    std::vector<bool> visited(graphNodes.size(), false);
+    std::vector<std::pair<size_t, size_t>> stack;
+    size_t visitedCount = 0;
+
+    visited[source] = true;
+    order[visitedCount++] = source;
+    stack.emplace_back(source, 0);
+    while (!stack.empty()) {
+        auto& top = stack.back();
+        auto& neighbors = adjacency[top.first];
+        if (top.second == neighbors.size()) {
+            stack.pop_back();
+            continue;
+        }
+
+        size_t neighbor = neighbors[top.second++];
+        if (!visited[neighbor]) {
+            visited[neighbor] = true;
+            order[visitedCount++] = neighbor;
+            stack.emplace_back(neighbor, 0);
+        }
+    }
+
+    return visitedCount;
+}
+
+ComponentLabels Graph::connectedComponents(size_t threadCount) const {
+    size_t count = graphNodes.size();
+    std::vector<std::atomic<size_t>> parent(count);
+    for (size_t slot = 0; slot < count; slot++) {
+        parent[slot].store(slot, std::memory_order_relaxed);
+    }
+
+    // finds the root and halves the path on the way, a failed compare exchange only skips the shortcut
+    auto find = [&parent](size_t node) {
+        while (true) {
+            size_t up = parent[node].load(std::memory_order_relaxed);
+            if (up == node) {
+                return node;
+            }
+            size_t upper = parent[up].load(std::memory_order_relaxed);
+            if (up != upper) {
+                parent[node].compare_exchange_weak(up, upper, std::memory_order_relaxed);
+            }
+            node = upper;
+        }
+    };
+
+    // links the root with the higher index under the other one, retries when a root was linked meanwhile
+    auto unite = [&parent, &find](size_t a, size_t b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return;
+            }
+            if (a < b) {
+                std::swap(a, b);
+            }
+            size_t expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+    };
+
+    parallelFor(count, threadCount, [&](size_t begin, size_t end, size_t) {
+        for (size_t slot = begin; slot < end; slot++) {
+            for (auto neighbor : adjacency[slot]) {
+                if (slot < neighbor) {
+                    unite(slot, neighbor);
+                }
+            }
+        }
+    });
+
+    // roots are final now, every node points at its root in one more parallel pass
+    std::vector<size_t> roots(count);
+    parallelFor(count, threadCount, [&](size_t begin, size_t end, size_t) {
+        for (size_t slot = begin; slot < end; slot++) {
+            roots[slot] = find(slot);
+        }
+    });
+
+    // a root always has the smallest index of its component, so it is labeled before any other member
+    ComponentLabels components;
+    components.labels.resize(count);
+    for (size_t slot = 0; slot < count; slot++) {
+        if (roots[slot] == slot) {
+            components.labels[slot] = components.sizes.size();
+            components.sizes.push_back(0);
+        } else {
+            components.labels[slot] = components.labels[roots[slot]];
+        }
+        components.sizes[components.labels[slot]]++;
+    }
+
+    return components;
+}
+
+/*** Konec souboru tdd_traversal.cpp ***/
@@ -0,0 +1,279 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph
+//
+// $NoKeywords: $ivs_project_1 $tdd_triangles.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_triangles.cpp
+ * @author David Bujzaš
+ *
+ * @brief Počítání trojúhelníků a shlukovacího koeficientu pomocí průniků seřazených seznamů sousedů.
+ */
+
+#include "tdd_code.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TRIANGLES_SSE2 1
+#endif
+
+#if defined(TRIANGLES_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TRIANGLES_AVX2 1
+#endif
+
+namespace {
+
+// counts set bits of a small comparison mask
+size_t bitCount(unsigned mask) {
+#ifdef __GNUC__
+    return static_cast<size_t>(__builtin_popcount(mask));
+#else
+    size_t count = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+size_t intersectScalar(const uint32_t* a, size_t sizeA, const uint32_t* b, size_t sizeB) {
+    size_t count = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < sizeA && j < sizeB) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            count++;
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+#ifdef TRIANGLES_SSE2
+// compares a block of 4 values of a with all 4 rotations of a block of b, the block with the smaller
+// last value is consumed, both when they are equal
+size_t intersectSse2(const uint32_t* a, size_t sizeA, const uint32_t* b, size_t sizeB) {
+    size_t count = 0;
+    size_t i = 0;
+    size_t j = 0;
+    size_t blocksA = sizeA & ~size_t(3);
+    size_t blocksB = sizeB & ~size_t(3);
+    while (i < blocksA && j < blocksB) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i match = _mm_cmpeq_epi32(va, vb);
+        for (int rotation = 1; rotation < 4; rotation++) {
+            vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+            match = _mm_or_si128(match, _mm_cmpeq_epi32(va, vb));
+        }
+        count += bitCount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(match))));
+
+        uint32_t lastA = a[i + 3];
+        uint32_t lastB = b[j + 3];
+        i += lastA <= lastB ? 4 : 0;
+        j += lastB <= lastA ? 4 : 0;
+    }
+    return count + intersectScalar(a + i, sizeA - i, b + j, sizeB - j);
+}
+#endif
+
+#ifdef TRIANGLES_AVX2
+// the same block scheme with 8 values, compiled for AVX2 only in this function and chosen at run time
+__attribute__((target("avx2")))
+size_t intersectAvx2(const uint32_t* a, size_t sizeA, const uint32_t* b, size_t sizeB) {
+    const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+    size_t count = 0;
+    size_t i = 0;
+    size_t j = 0;
+    size_t blocksA = sizeA & ~size_t(7);
+    size_t blocksB = sizeB & ~size_t(7);
+    while (i < blocksA && j < blocksB) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i match = _mm256_cmpeq_epi32(va, vb);
+        for (int rotation = 1; rotation < 8; rotation++) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            match = _mm256_or_si256(match, _mm256_cmpeq_epi32(va, vb));
+        }
+        count += bitCount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(match))));
+
+        uint32_t lastA = a[i + 7];
+        uint32_t lastB = b[j + 7];
+        i += lastA <= lastB ? 8 : 0;
+        j += lastB <= lastA ? 8 : 0;
+    }
+    return count + intersectSse2(a + i, sizeA - i, b + j, sizeB - j);
+}
+#endif
+
+// resolves Best and kernels the build or the processor does not support to the best available one
+IntersectKernel resolveKernel(IntersectKernel kernel) {
+    if (kernel == IntersectKernel::Best || kernel == IntersectKernel::Avx2) {
+        if (intersectKernelAvailable(IntersectKernel::Avx2)) {
+            return IntersectKernel::Avx2;
+        }
+        kernel = IntersectKernel::Sse2;
+    }
+    if (kernel == IntersectKernel::Sse2 && !intersectKernelAvailable(IntersectKernel::Sse2)) {
+        kernel = IntersectKernel::Scalar;
+    }
+    return kernel;
+}
+
+/**
+ * @brief Seznamy sousedů ve formátu CSR s 32bitovými indexy seřazenými vzestupně.
+ */
+struct SortedAdjacency{
+    std::vector<size_t> offsets;
+    std::vector<uint32_t> neighbors;
+
+    const uint32_t* at(size_t slot) const { return neighbors.data() + offsets[slot]; }
+    size_t size(size_t slot) const { return offsets[slot + 1] - offsets[slot]; }
+};
+
+// copies and sorts the neighbor lists, oriented keeps only the neighbors later in the degree order,
+// so every triangle is found exactly once from its first node
+SortedAdjacency buildSortedAdjacency(const Graph& graph, bool oriented, size_t threadCount) {
+    size_t count = graph.nodeCount();
+    // the lists hold 32-bit indices, a larger graph would silently produce wrong counts
+    if (count > uint64_t(UINT32_MAX) + 1) {
+        throw std::length_error("Graph has too many nodes for triangle counting!\n");
+    }
+    auto before = [&graph](size_t a, size_t b) {
+        size_t degreeA = graph.neighborsAt(a).size();
+        size_t degreeB = graph.neighborsAt(b).size();
+        return degreeA != degreeB ? degreeA < degreeB : a < b;
+    };
+
+    SortedAdjacency adjacency;
+    adjacency.offsets.assign(count + 1, 0);
+    for (size_t slot = 0; slot < count; slot++) {
+        size_t size = 0;
+        for (auto neighbor : graph.neighborsAt(slot)) {
+            size += !oriented || before(slot, neighbor);
+        }
+        adjacency.offsets[slot + 1] = adjacency.offsets[slot] + size;
+    }
+
+    adjacency.neighbors.resize(adjacency.offsets[count]);
+    parallelFor(count, threadCount, [&](size_t begin, size_t end, size_t) {
+        for (size_t slot = begin; slot < end; slot++) {
+            uint32_t* out = adjacency.neighbors.data() + adjacency.offsets[slot];
+            for (auto neighbor : graph.neighborsAt(slot)) {
+                if (!oriented || before(slot, neighbor)) {
+                    *out++ = static_cast<uint32_t>(neighbor);
+                }
+            }
+            std::sort(adjacency.neighbors.data() + adjacency.offsets[slot], out);
+        }
+    });
+    return adjacency;
+}
+
+} // namespace
+
+bool intersectKernelAvailable(IntersectKernel kernel) {
+    switch (kernel) {
+        case IntersectKernel::Scalar:
+        case IntersectKernel::Best:
+            return true;
+        case IntersectKernel::Sse2:
+#ifdef TRIANGLES_SSE2
+            return true;
+#else
+            return false;
+#endif
+        case IntersectKernel::Avx2:
+#ifdef TRIANGLES_AVX2
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+size_t intersectSortedCount(const uint32_t* a, size_t sizeA, const uint32_t* b, size_t sizeB,
+                            IntersectKernel kernel) {
+    switch (resolveKernel(kernel)) {
+#ifdef TRIANGLES_AVX2
+        case IntersectKernel::Avx2:
+            return intersectAvx2(a, sizeA, b, sizeB);
+#endif
+#ifdef TRIANGLES_SSE2
+        case IntersectKernel::Sse2:
+            return intersectSse2(a, sizeA, b, sizeB);
+#endif
+        default:
+            return intersectScalar(a, sizeA, b, sizeB);
+    }
+}
+
+size_t Graph::triangleCount(size_t threadCount, IntersectKernel kernel) const {
+    threadCount = std::max<size_t>(threadCount, 1);
+    kernel = resolveKernel(kernel);
+    SortedAdjacency oriented = buildSortedAdjacency(*this, true, threadCount);
+
+    std::vector<size_t> partial(threadCount, 0);
+    parallelFor(graphNodes.size(), threadCount, [&](size_t begin, size_t end, size_t thread) {
+        size_t count = 0;
+        for (size_t slot = begin; slot < end; slot++) {
+            const uint32_t* out = oriented.at(slot);
+            for (size_t i = 0; i < oriented.size(slot); i++) {
+                count += intersectSortedCount(out, oriented.size(slot), oriented.at(out[i]), oriented.size(out[i]),
+                                              kernel);
+            }
+        }
+        partial[thread] = count;
+    });
+
+    size_t total = 0;
+    for (auto count : partial) {
+        total += count;
+    }
+    return total;
+}
+
+// every triangle of a node is found once from each of its two other corners
+std::vector<size_t> Graph::nodeTriangles(size_t threadCount, IntersectKernel kernel) const {
+    threadCount = std::max<size_t>(threadCount, 1);
+    kernel = resolveKernel(kernel);
+    SortedAdjacency full = buildSortedAdjacency(*this, false, threadCount);
+
+    std::vector<size_t> triangles(graphNodes.size(), 0);
+    parallelFor(graphNodes.size(), threadCount, [&](size_t begin, size_t end, size_t) {
+        for (size_t slot = begin; slot < end; slot++) {
+            const uint32_t* neighbors = full.at(slot);
+            size_t count = 0;
+            for (size_t i = 0; i < full.size(slot); i++) {
+                count += intersectSortedCount(neighbors, full.size(slot), full.at(neighbors[i]),
+                                              full.size(neighbors[i]), kernel);
+            }
+            triangles[slot] = count / 2;
+        }
+    });
+    return triangles;
+}
+
+std::vector<double> Graph::clusteringCoefficients(size_t threadCount) const {
+    std::vector<size_t> triangles = nodeTriangles(threadCount);
+    std::vector<double> coefficients(triangles.size(), 0);
+    for (size_t slot = 0; slot < triangles.size(); slot++) {
+        double degree = static_cast<double>(adjacency[slot].size());
+        if (degree > 1) {
+            coefficients[slot] = 2 * static_cast<double>(triangles[slot]) / (degree * (degree - 1));
+        }
+    }
+    return coefficients;
+}
+
+/*** Konec souboru tdd_triangles.cpp ***/
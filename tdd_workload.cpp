@@ -0,0 +1,345 @@
+//======= Copyright (c) 2024, FIT VUT Brno, All rights reserved. ============//
+//
+// Purpose:     Test Driven Development - graph benchmarks
+//
+// $NoKeywords: $ivs_project_1 $tdd_workload.cpp
+// $Author:     David Bujzaš <xbujzad00@stud.fit.vutbr.cz>
+// $Date:       $2024-02-14
+//============================================================================//
+/**
+ * @file tdd_workload.cpp
+ * @author David Bujzaš
+ *
+ * @brief Sada měření operací grafu nad syntetickými grafy se strojově čitelným výstupem.
+ *
+ * Použití: tdd_workload [--format json|csv] [--sizes 1K,10K,100K,1M,10M] [--generators er,rmat,ba,grid]
+ *                       [--degree 8] [--seed 42] [--repeat 3] [--threads 1] [--output soubor]
+ *
+ * Každá operace se měří repeat krát na nově sestaveném grafu a vypíše se nejkratší čas.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tdd_code.h"
+#include "tdd_graph_generators.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// returns seconds elapsed since the given time point
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Options {
+    std::string format = "json";
+    std::vector<size_t> sizes = {1000, 10000, 100000, 1000000};
+    std::vector<GraphGenerator> generators = {GraphGenerator::ErdosRenyi, GraphGenerator::RMat,
+                                              GraphGenerator::BarabasiAlbert, GraphGenerator::Grid};
+    size_t degree = 8;
+    uint64_t seed = 42;
+    size_t repeat = 3;
+    size_t threads = 1;
+    std::string output;
+};
+
+struct Measurement {
+    std::string generator;
+    size_t nodes;
+    size_t edges;
+    std::string operation;
+    size_t operations;
+    double seconds;
+};
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    size_t begin = 0;
+    while (begin <= list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        if (end > begin) {
+            items.push_back(list.substr(begin, end - begin));
+        }
+        begin = end + 1;
+    }
+    return items;
+}
+
+// accepts plain numbers and K or M suffixes, 10M is 10000000, signs and values beyond size_t are rejected
+size_t parseCount(const std::string& text) {
+    size_t value = 0;
+    size_t pos = 0;
+    for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; pos++) {
+        size_t digit = static_cast<size_t>(text[pos] - '0');
+        if (value > (SIZE_MAX - digit) / 10) {
+            throw std::runtime_error("Invalid count " + text + "!\n");
+        }
+        value = value * 10 + digit;
+    }
+    std::string suffix = text.substr(pos);
+    size_t multiplier = 1;
+    if (suffix == "K" || suffix == "k") {
+        multiplier = 1000;
+    } else if (suffix == "M" || suffix == "m") {
+        multiplier = 1000000;
+    } else if (!suffix.empty()) {
+        throw std::runtime_error("Invalid count " + text + "!\n");
+    }
+    if (pos == 0 || value > SIZE_MAX / multiplier) {
+        throw std::runtime_error("Invalid count " + text + "!\n");
+    }
+    value *= multiplier;
+    return value;
+}
+
+GraphGenerator parseGenerator(const std::string& name) {
+    for (auto generator : {GraphGenerator::ErdosRenyi, GraphGenerator::RMat, GraphGenerator::BarabasiAlbert,
+                           GraphGenerator::Grid}) {
+        if (name == generatorName(generator)) {
+            return generator;
+        }
+    }
+    if (name == "er") {
+        return GraphGenerator::ErdosRenyi;
+    }
+    if (name == "ba") {
+        return GraphGenerator::BarabasiAlbert;
+    }
+    throw std::runtime_error("Unknown generator " + name + "!\n");
+}
+
+Options parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string name = argv[i];
+        if (i + 1 == argc) {
+            throw std::runtime_error("Missing value of " + name + "!\n");
+        }
+        std::string value = argv[++i];
+        if (name == "--format") {
+            if (value != "json" && value != "csv") {
+                throw std::runtime_error("Unknown format " + value + "!\n");
+            }
+            options.format = value;
+        } else if (name == "--sizes") {
+            options.sizes.clear();
+            for (auto& item : splitList(value)) {
+                options.sizes.push_back(parseCount(item));
+            }
+        } else if (name == "--generators") {
+            options.generators.clear();
+            for (auto& item : splitList(value)) {
+                options.generators.push_back(parseGenerator(item));
+            }
+        } else if (name == "--degree") {
+            options.degree = parseCount(value);
+        } else if (name == "--seed") {
+            options.seed = parseCount(value);
+        } else if (name == "--repeat") {
+            options.repeat = std::max<size_t>(parseCount(value), 1);
+        } else if (name == "--threads") {
+            options.threads = std::max<size_t>(parseCount(value), 1);
+        } else if (name == "--output") {
+            options.output = value;
+        } else {
+            throw std::runtime_error("Unknown option " + name + "!\n");
+        }
+    }
+    return options;
+}
+
+// one pass over all operations, graphs are rebuilt so that every pass starts from the same state,
+// edgeCount receives the number of distinct edges of the loaded graph
+std::vector<double> runOnce(size_t nodeCount, const std::vector<Edge>& edges, const std::vector<Edge>& queries,
+                            const std::vector<size_t>& victims, size_t threads, size_t graphDegreeCalls,
+                            size_t& edgeCount) {
+    std::vector<double> seconds;
+
+    Graph graph;
+    auto start = Clock::now();
+    for (size_t node = 0; node < nodeCount; node++) {
+        graph.addNode(node);
+    }
+    seconds.push_back(secondsSince(start));
+
+    start = Clock::now();
+    for (auto& edge : edges) {
+        graph.addEdge(edge);
+    }
+    seconds.push_back(secondsSince(start));
+    edgeCount = graph.edgeCount();
+
+    {
+        Graph bulk;
+        for (size_t node = 0; node < nodeCount; node++) {
+            bulk.addNode(node);
+        }
+        start = Clock::now();
+        bulk.addMultipleEdges(edges, threads);
+        seconds.push_back(secondsSince(start));
+    }
+
+    size_t found = 0;
+    start = Clock::now();
+    for (auto& query : queries) {
+        found += graph.containsEdge(query);
+    }
+    seconds.push_back(secondsSince(start));
+
+    size_t degrees = 0;
+    start = Clock::now();
+    for (size_t node = 0; node < nodeCount; node++) {
+        degrees += graph.nodeDegree(node);
+    }
+    seconds.push_back(secondsSince(start));
+
+    start = Clock::now();
+    for (size_t call = 0; call < graphDegreeCalls; call++) {
+        degrees += graph.graphDegree();
+    }
+    seconds.push_back(secondsSince(start));
+
+    start = Clock::now();
+    graph.coloring();
+    seconds.push_back(secondsSince(start));
+
+    start = Clock::now();
+    for (auto node : victims) {
+        graph.removeNode(node);
+    }
+    seconds.push_back(secondsSince(start));
+
+    // keeps the lookups from being optimized away
+    if (found + degrees == 0 && !edges.empty()) {
+        std::cerr << "unexpected empty results" << std::endl;
+    }
+    return seconds;
+}
+
+void benchGraph(const Options& options, GraphGenerator generator, size_t nodeCount,
+                std::vector<Measurement>& measurements) {
+    auto start = Clock::now();
+    std::vector<Edge> edges = generateEdges(generator, nodeCount, options.degree, options.seed);
+    double generating = secondsSince(start);
+
+    // half of the queries hit an existing edge, the other half is a random pair
+    std::mt19937_64 random(options.seed + 1);
+    std::vector<Edge> queries;
+    queries.reserve(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        if (i % 2 == 0) {
+            queries.push_back(edges[random() % edges.size()]);
+        } else {
+            queries.emplace_back(random() % nodeCount, random() % nodeCount);
+        }
+    }
+
+    std::vector<size_t> victims(nodeCount);
+    for (size_t node = 0; node < nodeCount; node++) {
+        victims[node] = node;
+    }
+    for (size_t i = nodeCount; i > 1; i--) {
+        std::swap(victims[i - 1], victims[random() % i]);
+    }
+    victims.resize(nodeCount / 10);
+
+    size_t graphDegreeCalls = 100;
+    size_t edgeCount = 0;
+    std::vector<double> best;
+    for (size_t pass = 0; pass < options.repeat; pass++) {
+        auto seconds = runOnce(nodeCount, edges, queries, victims, options.threads, graphDegreeCalls, edgeCount);
+        if (best.empty()) {
+            best = seconds;
+        }
+        for (size_t i = 0; i < seconds.size(); i++) {
+            best[i] = std::min(best[i], seconds[i]);
+        }
+    }
+
+    const char* name = generatorName(generator);
+    const char* operations[] = {"addNode", "addEdge", "addMultipleEdges", "containsEdge",
+                                "nodeDegree", "graphDegree", "coloring", "removeNode"};
+    const size_t counts[] = {nodeCount, edges.size(), edges.size(), queries.size(),
+                             nodeCount, graphDegreeCalls, nodeCount, victims.size()};
+    measurements.push_back({name, nodeCount, edgeCount, "generate", edges.size(), generating});
+    for (size_t i = 0; i < best.size(); i++) {
+        measurements.push_back({name, nodeCount, edgeCount, operations[i], counts[i], best[i]});
+    }
+}
+
+double nanosecondsPerOperation(const Measurement& measurement) {
+    return measurement.operations == 0 ? 0 : measurement.seconds * 1e9 / static_cast<double>(measurement.operations);
+}
+
+void writeCsv(std::ostream& out, const std::vector<Measurement>& measurements) {
+    out << "generator,nodes,edges,operation,operations,seconds,ns_per_op\n";
+    for (auto& m : measurements) {
+        out << m.generator << ',' << m.nodes << ',' << m.edges << ',' << m.operation << ',' << m.operations << ','
+            << m.seconds << ',' << nanosecondsPerOperation(m) << '\n';
+    }
+}
+
+void writeJson(std::ostream& out, const Options& options, const std::vector<Measurement>& measurements) {
+    out << "{\n  \"degree\": " << options.degree << ",\n  \"seed\": " << options.seed << ",\n  \"repeat\": "
+        << options.repeat << ",\n  \"threads\": " << options.threads << ",\n  \"results\": [";
+    for (size_t i = 0; i < measurements.size(); i++) {
+        auto& m = measurements[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"generator\": \"" << m.generator << "\", \"nodes\": " << m.nodes
+            << ", \"edges\": " << m.edges << ", \"operation\": \"" << m.operation << "\", \"operations\": "
+            << m.operations << ", \"seconds\": " << m.seconds << ", \"ns_per_op\": " << nanosecondsPerOperation(m)
+            << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what();
+        return 1;
+    }
+
+    // opens the output first, so a bad path fails before a long run and not after it
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Output file cannot be opened!" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Measurement> measurements;
+    for (auto generator : options.generators) {
+        for (auto size : options.sizes) {
+            benchGraph(options, generator, size, measurements);
+        }
+    }
+
+    std::ostream& out = options.output.empty() ? std::cout : file;
+    out.precision(9);
+    if (options.format == "csv") {
+        writeCsv(out, measurements);
+    } else {
+        writeJson(out, options, measurements);
+    }
+    return 0;
+}
+
+/*** Konec souboru tdd_workload.cpp ***/